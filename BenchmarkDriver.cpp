@@ -0,0 +1,1767 @@
+#include "Map.h"
+#include "Combat.h"
+#include "GameEngine.h"
+#include "MctsStrategy.h"
+#include "Orders.h"
+#include "OrderScheduler.h"
+#include "Player.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Benchmarks for the hot paths we care about on big generated maps.
+// Run all of them, or pass the name of one:  ./Warzone_bench layout
+
+// Every global operator new in this binary bumps a counter, so benchmarks
+// can report allocations. The whole C++14 family is replaced (array,
+// nothrow and sized forms), all on the same pair of helpers, so every new
+// is counted and every delete matches the new it came from. The helpers
+// stay out of line: once malloc/free are inlined into operator new/delete,
+// GCC pairs them up and reports -Wmismatched-new-delete.
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE
+#endif
+
+namespace {
+    std::atomic<long long> heapAllocations(0);
+
+    BENCH_NOINLINE void* countedAlloc(std::size_t size) noexcept {
+        heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        return std::malloc(size ? size : 1);
+    }
+    BENCH_NOINLINE void countedFree(void* p) noexcept {
+        std::free(p);
+    }
+}
+
+void* operator new(std::size_t size) {
+    if (void* p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { countedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { countedFree(p); }
+
+namespace {
+    // Small wall-clock helper
+    class Stopwatch {
+    private:
+        std::chrono::steady_clock::time_point start_;
+    public:
+        Stopwatch() : start_(std::chrono::steady_clock::now()) {}
+        double seconds() const {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+        }
+    };
+
+    // Build a w x h grid map: 4-neighbour borders, one continent per row band.
+    // Owners alternate between "P0".."P(players-1)".
+    Map* buildGridMap(int w, int h, int bands, int players) {
+        Map* m = new Map();
+        m->getStore()->reserve(w * h);
+        std::vector<Continent*> conts;
+        for (int b = 0; b < bands; b++) {
+            Continent* c = new Continent("C" + std::to_string(b), b + 1, new std::vector<Territory*>());
+            m->addContinent(c);
+            conts.push_back(c);
+        }
+        std::vector<Territory*> cells;
+        cells.reserve(w * h);
+        for (int i = 0; i < w * h; i++) {
+            int band = (i / w) * bands / h;
+            Territory* t = new Territory("T" + std::to_string(i), conts[band]->getName(),
+                                         "P" + std::to_string(i % players), 1 + i % 7, i + 1, nullptr);
+            m->getTerritories()->push_back(t);   // skip the O(n) duplicate scan
+            m->getStore()->adopt(t);
+            conts[band]->getTerritories()->push_back(t);
+            cells.push_back(t);
+        }
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                auto adj = cells[y * w + x]->getAdjacentTerritories();
+                if (x > 0) adj->push_back(cells[y * w + x - 1]);
+                if (x + 1 < w) adj->push_back(cells[y * w + x + 1]);
+                if (y > 0) adj->push_back(cells[(y - 1) * w + x]);
+                if (y + 1 < h) adj->push_back(cells[(y + 1) * w + x]);
+            }
+        }
+        return m;
+    }
+
+    // --------------------------------------------------------------------
+    // layout: full-map scans, old pointer-per-field layout vs. the store
+    // --------------------------------------------------------------------
+
+    // Replica of the pre-store Territory layout (every field its own heap block)
+    struct LegacyTerritory {
+        std::string* name;
+        std::string* continent;
+        std::string* owner;
+        int* armies;
+        int* id;
+        LegacyTerritory(const std::string& n, const std::string& c, const std::string& o, int a, int i)
+            : name(new std::string(n)), continent(new std::string(c)), owner(new std::string(o)),
+              armies(new int(a)), id(new int(i)) {}
+        ~LegacyTerritory() { delete name; delete continent; delete owner; delete armies; delete id; }
+        std::string getOwner() const { return *owner; }
+        int getArmies() const { return *armies; }
+    };
+
+    void benchLayout() {
+        const int side = 224;               // ~50k territories
+        const int n = side * side;
+        const int reps = 20;
+        Map* m = buildGridMap(side, side, 8, 4);
+
+        std::vector<LegacyTerritory*> legacy;
+        legacy.reserve(n);
+        for (auto t : *m->getTerritories()) {
+            legacy.push_back(new LegacyTerritory(t->getName(), t->getContinent(), t->getOwner(),
+                                                 t->getArmies(), t->getId()));
+        }
+
+        long long sink = 0;
+        const std::string who = "P1";
+
+        Stopwatch s1;
+        for (int r = 0; r < reps; r++) {
+            for (auto t : legacy) {
+                if (t->getOwner() == who) sink += t->getArmies();
+            }
+        }
+        double legacyTime = s1.seconds();
+
+        Stopwatch s2;
+        for (int r = 0; r < reps; r++) {
+            for (auto t : *m->getTerritories()) {
+                if (t->isOwnedBy(who)) sink += t->getArmies();
+            }
+        }
+        double handleTime = s2.seconds();
+
+        Stopwatch s3;
+        const TerritoryStore* st = m->getStore();
+        for (int r = 0; r < reps; r++) {
+            const int ownerIdx = st->findOwner(who);
+            const int* owners = st->getOwners().data();
+            const int* armies = st->getArmies().data();
+            for (int i = 0; i < st->size(); i++) {
+                if (owners[i] == ownerIdx) sink += armies[i];
+            }
+        }
+        double storeTime = s3.seconds();
+
+        double scans = (double)n * reps;
+        std::cout << "[layout] " << n << " territories x " << reps << " scans\n";
+        std::cout << "  legacy heap fields : " << legacyTime * 1e9 / scans << " ns/territory\n";
+        std::cout << "  Territory handles  : " << handleTime * 1e9 / scans << " ns/territory\n";
+        std::cout << "  store arrays       : " << storeTime * 1e9 / scans << " ns/territory\n";
+        std::cout << "  (checksum " << sink << ")\n";
+
+        for (auto t : legacy) delete t;
+        delete m;
+    }
+
+    // --------------------------------------------------------------------
+    // adjacency: isAdjacent point queries on a hub-heavy map
+    // --------------------------------------------------------------------
+
+    // Grid plus a few hubs bordering many random territories
+    void addHubs(Map* m, int hubs, int degree, std::mt19937& gen) {
+        auto& ts = *m->getTerritories();
+        std::uniform_int_distribution<int> pick(0, (int)ts.size() - 1);
+        for (int h = 0; h < hubs; h++) {
+            Territory* hub = ts[pick(gen)];
+            for (int k = 0; k < degree; k++) {
+                Territory* other = ts[pick(gen)];
+                if (other == hub) continue;
+                hub->getAdjacentTerritories()->push_back(other);
+                other->getAdjacentTerritories()->push_back(hub);
+            }
+        }
+        m->buildAdjacencyIndex();
+    }
+
+    void benchAdjacencyOn(int side, int hubs, int degree) {
+        std::mt19937 gen(42);
+        Map* m = buildGridMap(side, side, 4, 4);
+        addHubs(m, hubs, degree, gen);
+        auto& ts = *m->getTerritories();
+
+        // Queries: half real borders (hub edges included), half random pairs
+        const int queries = 1000000;
+        std::vector<std::pair<Territory*, Territory*>> qs;
+        qs.reserve(queries);
+        std::uniform_int_distribution<int> pick(0, (int)ts.size() - 1);
+        while ((int)qs.size() < queries) {
+            Territory* a = ts[pick(gen)];
+            auto adj = a->getAdjacentTerritories();
+            if (qs.size() % 2 == 0 && !adj->empty()) {
+                qs.push_back(std::make_pair(a, (*adj)[gen() % adj->size()]));
+            } else {
+                qs.push_back(std::make_pair(a, ts[pick(gen)]));
+            }
+        }
+        // Hubs are asked about the most in real games (every attack into/out of them)
+        Territory* hub = nullptr;
+        for (auto t : ts) if (t->getAdjacentTerritories()->size() > 4) { hub = t; break; }
+        for (int i = 0; hub && i < queries / 4; i++) qs[i * 4].first = hub;
+
+        long long hits = 0;
+        Stopwatch s1;
+        for (auto& q : qs) {
+            for (auto t : *q.first->getAdjacentTerritories()) {
+                if (*t == *q.second) { hits++; break; }
+            }
+        }
+        double linear = s1.seconds();
+
+        Stopwatch s2;
+        for (auto& q : qs) hits += q.first->isAdjacent(*q.second);
+        double indexed = s2.seconds();
+
+        Stopwatch s3;
+        for (int i = 0; i < queries / 10; i++) {
+            auto& q = qs[i];
+            for (auto t : *q.first->getAdjacentTerritories()) {
+                if (t->getName() == q.second->getName()) { hits++; break; }
+            }
+        }
+        double linearName = s3.seconds() * 10;
+
+        std::vector<std::string> names;
+        names.reserve(queries / 10);
+        for (int i = 0; i < queries / 10; i++) names.push_back(qs[i].second->getName());
+        Stopwatch s4;
+        for (int i = 0; i < queries / 10; i++) hits += qs[i].first->isAdjacent(names[i]);
+        double indexedName = s4.seconds() * 10;
+
+        std::cout << "[adjacency] " << ts.size() << " territories, " << hubs << " hubs of degree ~"
+                  << degree << " (" << (ts.size() <= (size_t)TerritoryStore::DENSE_ADJACENCY_LIMIT
+                                        ? "dense bitset" : "edge hash") << ")\n";
+        std::cout << "  by territory: linear " << linear * 1e9 / queries << " ns, indexed "
+                  << indexed * 1e9 / queries << " ns\n";
+        std::cout << "  by name     : linear " << linearName * 1e9 / queries << " ns, indexed "
+                  << indexedName * 1e9 / queries << " ns\n";
+        std::cout << "  (hits " << hits << ")\n";
+        delete m;
+    }
+
+    void benchAdjacency() {
+        benchAdjacencyOn(60, 8, 400);      // 3600 territories
+        benchAdjacencyOn(224, 32, 2000);   // ~50k territories
+    }
+
+    // --------------------------------------------------------------------
+    // load: getline/istringstream loader vs. memory-mapped loader
+    // --------------------------------------------------------------------
+
+    // Write a w x h grid map in the .map text format
+    void writeGridMapFile(const std::string& path, int w, int h, int bands) {
+        std::ofstream out(path);
+        out << "; generated " << w << "x" << h << " grid\n[continents]\n";
+        for (int b = 0; b < bands; b++) out << "Band" << b << " " << b + 1 << "\n";
+        out << "[territories]\n";
+        for (int i = 0; i < w * h; i++) {
+            out << i + 1 << " T" << i << " " << (i / w) * bands / h + 1 << " Neutral " << i % 5 << "\n";
+        }
+        out << "[borders]\n";
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                out << y * w + x + 1;
+                if (x > 0) out << " " << y * w + x;
+                if (x + 1 < w) out << " " << y * w + x + 2;
+                if (y > 0) out << " " << (y - 1) * w + x + 1;
+                if (y + 1 < h) out << " " << (y + 1) * w + x + 1;
+                out << "\n";
+            }
+        }
+    }
+
+    void benchLoad() {
+        const std::string path = "bench_grid.map";
+        writeGridMapFile(path, 100, 100, 10);
+
+        MapLoader loader;
+        MapLoadOptions quiet;
+        quiet.quiet = true;
+        quiet.validate = false;
+
+        // Legacy path logs every line; send that to a buffer we throw away
+        std::streambuf* saved = std::cout.rdbuf();
+        std::ostringstream sink;
+        std::cout.rdbuf(sink.rdbuf());
+        Stopwatch s1;
+        loader.loadMap(path);
+        double legacy = s1.seconds();
+        std::cout.rdbuf(saved);
+
+        loader.loadMap(path, quiet);
+        const MapLoadStats& st = loader.getLastLoadStats();
+
+        std::cout << "[load] " << st.territories << " territories, " << st.bytes << " bytes\n";
+        std::cout << "  getline loader (incl. validate): " << legacy * 1000.0 << " ms\n";
+        std::cout << "  mapped loader, quiet           : " << st.seconds * 1000.0 << " ms ("
+                  << st.megabytesPerSecond() << " MB/s)\n";
+        std::remove(path.c_str());
+    }
+
+    // --------------------------------------------------------------------
+    // binary: text load + validate vs. trusted binary load
+    // --------------------------------------------------------------------
+    void benchBinary() {
+        const std::string path = "bench_grid.map";
+        const std::string bin = "bench_grid.wzb";
+        writeGridMapFile(path, 100, 100, 10);
+
+        MapLoadOptions quiet;
+        quiet.quiet = true;
+
+        std::streambuf* saved = std::cout.rdbuf();
+        std::ostringstream sink;
+        std::cout.rdbuf(sink.rdbuf());   // validate() still prints its verdict
+        MapLoader loader;
+        Stopwatch s1;
+        bool ok = loader.loadMap(path, quiet);
+        double text = s1.seconds();
+        loader.saveBinary(bin);
+
+        MapLoadOptions trusted = quiet;
+        trusted.trusted = true;
+        MapLoader binLoader;
+        Stopwatch s2;
+        bool okBin = binLoader.loadBinary(bin, trusted);
+        double binary = s2.seconds();
+        std::cout.rdbuf(saved);
+
+        std::cout << "[binary] " << binLoader.getLastLoadStats().territories << " territories, "
+                  << binLoader.getLastLoadStats().bytes << " bytes on disk\n";
+        std::cout << "  text load + validate : " << text * 1000.0 << " ms" << (ok ? "" : " (FAILED)") << "\n";
+        std::cout << "  trusted binary load  : " << binary * 1000.0 << " ms ("
+                  << binLoader.getLastLoadStats().megabytesPerSecond() << " MB/s)"
+                  << (okBin ? "" : " (FAILED)") << "\n";
+
+        // Damaged files must be rejected, not read past the end: one cut
+        // short, and one with a valid checksum but border offsets that step
+        // far past edgeCount and back ({0, 1000000, ...})
+        std::string bytes;
+        {
+            std::ifstream in(bin, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        const std::string bad = "bench_bad.wzb";
+        auto rejects = [&](const std::string& contents) {
+            std::ofstream(bad, std::ios::binary | std::ios::trunc).write(contents.data(), contents.size());
+            MapLoadOptions silent;
+            silent.silent = true;
+            MapLoader l;
+            return !l.loadBinary(bad, silent);
+        };
+        const bool truncated = rejects(bytes.substr(0, bytes.size() / 2));
+
+        // header: magic[8], then u32 version, byteOrder, flags, continentCount,
+        // territoryCount, edgeCount, memberCount, stringCount, stringBytes,
+        // reserved, then the u64 checksum of the payload (see Map.cpp)
+        auto field = [&bytes](std::size_t at) {
+            unsigned v;
+            std::memcpy(&v, bytes.data() + at, sizeof(v));
+            return (std::size_t)v;
+        };
+        const std::size_t headerSize = 56;
+        const std::size_t borderOffsetsAt = headerSize + 4 * (field(36) + 1) + field(40)
+                                          + 8 * field(20) + 20 * field(24);
+        std::string corrupt = bytes;
+        const unsigned far = 1000000;
+        std::memcpy(&corrupt[borderOffsetsAt + 4], &far, sizeof(far));
+        unsigned long long h = 14695981039346656037ULL;   // re-sign it (FNV-1a)
+        for (std::size_t i = headerSize; i < corrupt.size(); i++) {
+            h ^= (unsigned char)corrupt[i];
+            h *= 1099511628211ULL;
+        }
+        std::memcpy(&corrupt[48], &h, sizeof(h));
+        const bool badOffsets = rejects(corrupt);
+        std::cout << "  damaged files rejected: truncated " << (truncated ? "ok" : "FAILED")
+                  << ", corrupt border offsets " << (badOffsets ? "ok" : "FAILED") << "\n";
+
+        // a map edited after a good load is saved unvalidated, so a trusted
+        // load still checks it (an emptied continent fails)
+        (*loader.getMap()->getContinents())[0]->getTerritories()->clear();
+        loader.saveBinary(bin);
+        MapLoadOptions trustedSilent = trusted;
+        trustedSilent.silent = true;
+        MapLoader editedLoader;
+        const bool editedRejected = !editedLoader.loadBinary(bin, trustedSilent);
+        std::cout << "  edited map re-validated on trusted load: " << (editedRejected ? "ok" : "FAILED") << "\n";
+        std::remove(bad.c_str());
+        std::remove(path.c_str());
+        std::remove(bin.c_str());
+    }
+
+    // --------------------------------------------------------------------
+    // scaling: per-territory load cost from 1k to 1M territories
+    // --------------------------------------------------------------------
+    void benchScaling() {
+        const int sides[] = {32, 100, 317, 1000};   // ~1k, 10k, 100k, 1M
+        const std::string path = "bench_scaling.map";
+        MapLoadOptions quiet;
+        quiet.quiet = true;
+        quiet.validate = false;
+
+        std::cout << "[scaling] mapped loader, no validation\n";
+        for (int side : sides) {
+            writeGridMapFile(path, side, side, 16);
+            MapLoader loader;
+            bool ok = loader.loadMap(path, quiet);
+            const MapLoadStats& st = loader.getLastLoadStats();
+            std::cout << "  " << st.territories << " territories, " << st.borders << " borders: "
+                      << st.seconds * 1000.0 << " ms, "
+                      << st.seconds * 1e9 / (st.territories + st.borders) << " ns/element"
+                      << (ok ? "" : " (FAILED)") << "\n";
+        }
+        std::remove(path.c_str());
+
+        // The ID indexes after edits through the raw vectors: a same-size
+        // swap, then adds into a continent whose vector holds a duplicate
+        // (both used to leave the index stale or rebuild it on every add)
+        Map* m = buildGridMap(100, 100, 1, 2);
+        std::vector<Continent*>& conts = *m->getContinents();
+        Continent* swapped = new Continent("Swapped", 999, new std::vector<Territory*>());
+        delete conts[0];
+        conts[0] = swapped;
+        const bool swapFound = m->findContinent(999) == swapped && m->findContinent(1) == nullptr;
+
+        std::vector<Territory*>& members = *swapped->getTerritories();
+        std::vector<Territory*>* all = m->getTerritories();
+        members.push_back((*all)[0]);
+        members.push_back((*all)[0]);
+        Stopwatch sw;
+        for (auto t : *all) swapped->addTerritory(t);
+        const double addMs = sw.seconds() * 1000.0;
+        std::cout << "  raw-vector edits: swapped continent " << (swapFound ? "found" : "MISSING")
+                  << ", " << all->size() << " adds after a duplicate: " << addMs << " ms ("
+                  << members.size() << " members)\n";
+        delete m;
+
+        // Reads through a const Map between adds keep the index (only the
+        // editing getters mark it stale), so this stays linear
+        Map grown;
+        const Map& view = grown;
+        const int adds = 20000;
+        Stopwatch sg;
+        std::size_t seen = 0;
+        for (int i = 0; i < adds; i++) {
+            grown.addTerritory(new Territory("G" + std::to_string(i), "C0", "P0", 1, i + 1, nullptr));
+            seen += view.getTerritories()->size();
+        }
+        std::cout << "  " << adds << " adds, each followed by a const read: " << sg.seconds() * 1000.0
+                  << " ms" << (seen == (std::size_t)adds * (adds + 1) / 2 ? "" : " (FAILED)") << "\n";
+
+        // Renumbering a territory has to reach both ID indexes: the map finds
+        // it under the new ID only, and the old ID is free again for a
+        // continent that already holds it
+        Territory* renamed = grown.findTerritory(7);
+        std::vector<Territory*> held(1, renamed);
+        Continent holder("Holder", 1, &held);
+        renamed->setId(adds + 1);
+        Territory* reused = new Territory("Reused", "C0", "P0", 1, 7, nullptr);
+        grown.addTerritory(reused);
+        holder.addTerritory(reused);
+        const bool renumbered = grown.findTerritory(adds + 1) == renamed && grown.findTerritory(7) == reused
+                                && holder.getTerritories()->size() == 2;
+        std::cout << "  setId reaches the map and continent indexes: " << (renumbered ? "ok" : "FAILED") << "\n";
+    }
+
+    // --------------------------------------------------------------------
+    // validate: legacy validate() vs. the validation engine
+    // --------------------------------------------------------------------
+
+    // Runs f with std::cout discarded (validate() always prints its verdict)
+    template <typename F>
+    double timedQuietly(F f) {
+        std::streambuf* saved = std::cout.rdbuf();
+        std::ostringstream sink;
+        std::cout.rdbuf(sink.rdbuf());
+        Stopwatch sw;
+        f();
+        double t = sw.seconds();
+        std::cout.rdbuf(saved);
+        return t;
+    }
+
+    void benchValidate() {
+        ValidationOptions serial;
+        serial.threads = 1;
+        ValidationOptions parallel;   // one thread per core
+        ThreadPool pool;
+        ValidationOptions pooled;
+        pooled.pool = &pool;
+
+        Map* small = buildGridMap(100, 100, 16, 4);
+        small->buildAdjacencyIndex();
+        double legacy = timedQuietly([&] { small->validate(); });
+        double engine1 = timedQuietly([&] { small->validate(serial); });
+        std::cout << "[validate] " << small->getTerritories()->size() << " territories, 16 continents\n";
+        std::cout << "  validate()              : " << legacy * 1000.0 << " ms\n";
+        std::cout << "  engine, 1 thread        : " << engine1 * 1000.0 << " ms\n";
+        delete small;
+
+        Map* big = buildGridMap(1000, 1000, 64, 4);
+        big->buildAdjacencyIndex();
+        double big1 = timedQuietly([&] { big->validate(serial); });
+        double bigN = timedQuietly([&] { big->validate(parallel); });
+        double bigP = timedQuietly([&] { big->validate(pooled); });
+        std::cout << "[validate] " << big->getTerritories()->size() << " territories, 64 continents\n";
+        std::cout << "  engine, 1 thread        : " << big1 * 1000.0 << " ms\n";
+        std::cout << "  engine, " << ThreadPool::defaultThreadCount() << " threads       : "
+                  << bigN * 1000.0 << " ms\n";
+        std::cout << "  engine, reused pool     : " << bigP * 1000.0 << " ms\n";
+        delete big;
+    }
+
+    // --------------------------------------------------------------------
+    // paths: stress validation on 1M-node chain maps (deep traversals)
+    // --------------------------------------------------------------------
+
+    // 1 - 2 - 3 - ... - n, split into `bands` consecutive continents
+    Map* buildPathMap(int n, int bands) {
+        Map* m = buildGridMap(n, 1, 1, 2);
+        if (bands > 1) {
+            std::vector<Territory*> all = *(*m->getContinents())[0]->getTerritories();
+            std::vector<Continent*> conts;
+            for (int b = 0; b < bands; b++) {
+                std::vector<Territory*> part(all.begin() + (long)n * b / bands,
+                                             all.begin() + (long)n * (b + 1) / bands);
+                conts.push_back(new Continent("Band" + std::to_string(b), b + 1, &part));
+            }
+            m->setContinents(&conts);
+            for (auto c : conts) delete c;
+        }
+        m->buildAdjacencyIndex();
+        return m;
+    }
+
+    bool check(const char* what, bool got, bool expected) {
+        std::cout << "  " << what << ": " << (got == expected ? "ok" : "FAILED") << "\n";
+        return got == expected;
+    }
+
+    void stressPaths() {
+        const int n = 1000000;
+        bool allOk = true;
+        std::cout << "[paths] " << n << "-territory chains\n";
+
+        Map* one = buildPathMap(n, 1);
+        bool r = false;
+        double t = timedQuietly([&] { r = one->validate(); });
+        allOk &= check("single continent chain is valid", r, true);
+        std::cout << "    (" << t * 1000.0 << " ms)\n";
+
+        GraphTraversal walk(*one->getStore());
+        int reached = walk.run(0, GraphTraversal::DepthFirst);
+        allOk &= check("DFS reaches every territory", reached == n, true);
+        walk.reset();
+        reached = walk.run(n / 2, GraphTraversal::BreadthFirst, [n](int slot) { return slot < n / 2 + 10; });
+        allOk &= check("filtered BFS stops at the filter", reached == n / 2 + 10, true);
+
+        // Cut the chain in the middle: both the map and its continent break
+        auto& ts = *one->getTerritories();
+        ts[n / 2]->removeAdjacentTerritory(ts[n / 2 + 1]);
+        ts[n / 2 + 1]->removeAdjacentTerritory(ts[n / 2]);
+        t = timedQuietly([&] { r = one->validate(); });
+        allOk &= check("cut chain is rejected", r, false);
+        std::cout << "    (" << t * 1000.0 << " ms)\n";
+        delete one;
+
+        Map* banded = buildPathMap(n, 100);
+        ValidationOptions parallel;
+        t = timedQuietly([&] { r = banded->validate(parallel); });
+        allOk &= check("100-continent chain is valid (parallel)", r, true);
+        std::cout << "    (" << t * 1000.0 << " ms)\n";
+        delete banded;
+
+        std::cout << "  " << (allOk ? "all checks passed" : "SOME CHECKS FAILED") << "\n";
+    }
+
+    // --------------------------------------------------------------------
+    // report: one validateAll() pass vs. validate() re-runs
+    // --------------------------------------------------------------------
+
+    void benchReport() {
+        ValidationOptions quiet;
+        quiet.log = false;
+        Map* m = buildGridMap(1000, 1000, 64, 4);
+
+        // Break it in `cuts` places: isolate every 100000th territory
+        const int cuts = 10;
+        auto& ts = *m->getTerritories();
+        for (int k = 0; k < cuts; k++) {
+            Territory* t = ts[(std::size_t)k * 100000 + 500];
+            std::vector<Territory*> nbs = *t->getAdjacentTerritories();
+            for (auto nb : nbs) {
+                t->removeAdjacentTerritory(nb);
+                nb->removeAdjacentTerritory(t);
+            }
+        }
+        m->buildAdjacencyIndex();
+
+        Stopwatch sw;
+        bool ok = m->validate(quiet);
+        double first = sw.seconds();
+        Stopwatch sw2;
+        ValidationReport report = m->validateAll(quiet);
+        double all = sw2.seconds();
+
+        std::cout << "[report] " << ts.size() << " territories, " << cuts << " isolated\n";
+        std::cout << "  validate() (first failure) : " << first * 1000.0 << " ms, "
+                  << (ok ? "passed" : "failed") << "\n";
+        std::cout << "  validateAll()              : " << all * 1000.0 << " ms, "
+                  << report.errorCount << " errors, " << report.mapComponents.size()
+                  << " map components\n";
+        std::cout << "  fix-and-rerun estimate     : " << first * 1000.0 * (cuts + 1)
+                  << " ms for " << cuts + 1 << " validate() runs\n";
+        delete m;
+    }
+
+    // --------------------------------------------------------------------
+    // orders: execution engine throughput (deploy + advance every territory)
+    // --------------------------------------------------------------------
+
+    // One Player per "P<i>" owner of a grid map, holding its territories
+    std::vector<Player*> makeGridPlayers(Map* m, int players,
+                                         OrdersStorage storage = OrdersStorage::Objects) {
+        std::vector<std::vector<Territory*>> owned(players);
+        for (auto t : *m->getTerritories()) {
+            owned[std::stoi(t->getOwner().substr(1))].push_back(t);
+        }
+        std::vector<Player*> ps;
+        for (int p = 0; p < players; p++) {
+            ps.push_back(new Player("P" + std::to_string(p), owned[p], new Deck(), new OrdersList(storage)));
+            ps.back()->setId(p);
+        }
+        return ps;
+    }
+
+    void benchOrders() {
+        const int players = 4;
+        const int rounds = 10;
+        Map* m = buildGridMap(200, 200, 16, players);
+        m->buildAdjacencyIndex();
+        std::vector<Player*> ps = makeGridPlayers(m, players);
+
+        ExecutionContext ctx;
+        ctx.map = m;
+        ctx.players = &ps;
+        ctx.combat.setSeed(42);
+
+        std::mt19937 pick(7);
+        double execSeconds = 0.0;
+        long long total = 0;
+        long long valid = 0;
+        for (int r = 0; r < rounds; r++) {
+            // every territory gets a Deploy, then pushes half its armies at a random neighbor
+            for (auto* p : ps) {
+                for (auto* t : p->getTerritory()) {
+                    p->getOrder()->add(new Deploy(p, t, 3));
+                    auto adj = t->getAdjacentTerritories();
+                    Territory* to = (*adj)[pick() % adj->size()];
+                    p->getOrder()->add(new Advance(p, to, t, 1 + t->getArmies() / 2));
+                }
+            }
+            for (auto* p : ps) total += p->getOrder()->size();
+            Stopwatch sw;
+            valid += executeRound(ps, ctx);
+            execSeconds += sw.seconds();
+        }
+
+        std::cout << "[orders] " << m->getTerritories()->size() << " territories, " << players
+                  << " players, " << rounds << " rounds\n";
+        std::cout << "  orders executed : " << total << " (" << valid << " valid)\n";
+        std::cout << "  execution       : " << execSeconds * 1000.0 << " ms ("
+                  << total / execSeconds << " orders/s)\n";
+        for (auto* p : ps) {
+            std::cout << "  " << p->getPName() << " holds " << p->getTerritory().size() << " territories\n";
+        }
+        for (auto* p : ps) delete p;
+        delete m;
+    }
+
+    // --------------------------------------------------------------------
+    // combat: per-army mt19937 rolls vs. the counter-based combat kernel
+    // --------------------------------------------------------------------
+
+    void benchCombat() {
+        const int count = 200000;
+        std::mt19937 sizes(11);
+        std::vector<Battle> battles(count);
+        long long armies = 0;
+        for (auto& b : battles) {
+            b.attackers = 1 + sizes() % 200;
+            b.defenders = 1 + sizes() % 200;
+            armies += b.attackers + b.defenders;
+        }
+
+        // What Advance did before the kernel: one bernoulli draw per army
+        std::vector<Battle> legacy = battles;
+        std::mt19937 rng(42);
+        std::bernoulli_distribution attackHit(0.6), defendHit(0.7);
+        Stopwatch sw;
+        for (auto& b : legacy) {
+            int ak = 0, dk = 0;
+            for (int i = 0; i < b.attackers; i++) ak += attackHit(rng);
+            for (int i = 0; i < b.defenders; i++) dk += defendHit(rng);
+            b.defendersLeft = std::max(0, b.defenders - ak);
+            b.attackersLeft = std::max(0, b.attackers - dk);
+        }
+        double tLegacy = sw.seconds();
+
+        CombatKernel kernel(42);
+        std::vector<Battle> serial = battles;
+        Stopwatch sw2;
+        kernel.resolveBatch(serial, 0);
+        double tSerial = sw2.seconds();
+
+        ThreadPool pool(std::max(4, ThreadPool::defaultThreadCount()));   // >1 so the chunked path runs
+        std::vector<Battle> pooled = battles;
+        Stopwatch sw3;
+        kernel.resolveBatch(pooled, 0, &pool);
+        double tPooled = sw3.seconds();
+
+        bool same = true;
+        for (int i = 0; i < count; i++) {
+            same &= serial[i].attackersLeft == pooled[i].attackersLeft
+                 && serial[i].defendersLeft == pooled[i].defendersLeft;
+        }
+
+        std::cout << "[combat] " << count << " battles, " << armies << " armies\n";
+        std::cout << "  mt19937 per army        : " << tLegacy * 1000.0 << " ms ("
+                  << armies / tLegacy / 1e6 << " M rolls/s)\n";
+        std::cout << "  kernel, serial          : " << tSerial * 1000.0 << " ms ("
+                  << armies / tSerial / 1e6 << " M rolls/s)\n";
+        std::cout << "  kernel, " << pool.size() << " threads       : " << tPooled * 1000.0 << " ms\n";
+        check("same results for any thread count", same, true);
+
+        // Hit rates, exact path and binomial fallback
+        const int n = 1000, big = 10000000;
+        long long exact = 0, approx = 0;
+        for (int i = 0; i < 1000; i++) {
+            exact += kernel.hits(i, 0, n, CombatKernel::ATTACK_HIT);
+            approx += kernel.hits(i, 1, big, CombatKernel::DEFEND_HIT);
+        }
+        std::cout << "  mean hits, 1000 x 60%   : " << exact / 1000.0 << " (expect 600)\n";
+        std::cout << "  mean hits, 1e7 x 70%    : " << approx / 1000.0 << " (expect 7e6)\n";
+        Battle huge;
+        huge.attackers = 50000000;
+        huge.defenders = 30000000;
+        Stopwatch sw4;
+        kernel.resolve(huge, 0);
+        std::cout << "  50M vs 30M armies       : " << sw4.seconds() * 1e6 << " us ("
+                  << huge.attackersLeft << " vs " << huge.defendersLeft << " left)\n";
+    }
+
+    // --------------------------------------------------------------------
+    // arena: 1M orders per round, heap Orders* vs. arena-backed records
+    // --------------------------------------------------------------------
+
+    struct RoundCost {
+        long long allocations = 0;   // issue + execute + clear
+        double issueSeconds = 0.0;
+        double executeSeconds = 0.0;
+    };
+
+    // Issue a Deploy and an Advance for every territory, execute, clear
+    RoundCost arenaRound(std::vector<Player*>& ps, ExecutionContext& ctx, bool records, std::mt19937& pick) {
+        RoundCost cost;
+        const long long before = heapAllocations.load();
+        Stopwatch issue;
+        for (auto* p : ps) {
+            OrdersList* list = p->getOrder();
+            for (auto* t : p->getTerritory()) {
+                auto adj = t->getAdjacentTerritories();
+                Territory* to = (*adj)[pick() % adj->size()];
+                int armies = 1 + t->getArmies() / 2;
+                if (records) {
+                    list->addRecord(OrderRecord{OrderKind::Deploy, p->getId(), t->getIndex(), -1, 3});
+                    list->addRecord(OrderRecord{OrderKind::Advance, p->getId(), to->getIndex(), t->getIndex(), armies});
+                } else {
+                    list->add(new Deploy(p, t, 3));
+                    list->add(new Advance(p, to, t, armies));
+                }
+            }
+        }
+        cost.issueSeconds = issue.seconds();
+        Stopwatch execute;
+        executeRound(ps, ctx);   // includes clearing the lists
+        cost.executeSeconds = execute.seconds();
+        cost.allocations = heapAllocations.load() - before;
+        return cost;
+    }
+
+    void benchArena() {
+        const int players = 4;
+        const int rounds = 3;
+        for (int mode = 0; mode < 2; mode++) {
+            const bool records = mode == 1;
+            Map* m = buildGridMap(1000, 500, 16, players);
+            m->buildAdjacencyIndex();
+            std::vector<Player*> ps = makeGridPlayers(m, players,
+                                                      records ? OrdersStorage::Records : OrdersStorage::Objects);
+            ExecutionContext ctx;
+            ctx.map = m;
+            ctx.players = &ps;
+            std::mt19937 pick(7);
+
+            if (mode == 0) {
+                std::cout << "[arena] " << m->getTerritories()->size() << " territories, "
+                          << 2 * m->getTerritories()->size() << " orders per round\n";
+            }
+            for (int r = 0; r < rounds; r++) {
+                RoundCost cost = arenaRound(ps, ctx, records, pick);
+                std::cout << "  " << (records ? "records" : "Orders*") << " round " << r + 1 << ": "
+                          << cost.allocations << " allocations, issue " << cost.issueSeconds * 1000.0
+                          << " ms, execute " << cost.executeSeconds * 1000.0 << " ms\n";
+            }
+            for (auto* p : ps) delete p;
+            delete m;
+        }
+        std::cout << "  (what records still allocate: getTerritory() copies, conquered-list growth)\n";
+    }
+
+    // --------------------------------------------------------------------
+    // copy: OrdersList / Player copies as the list grows
+    // --------------------------------------------------------------------
+    // Orders only reference their player and territories, so a copy is one
+    // clone per order: time and allocations per order should stay flat.
+
+    void benchCopy() {
+        Map* m = buildGridMap(200, 100, 16, 2);
+        m->buildAdjacencyIndex();
+        std::vector<Player*> ps = makeGridPlayers(m, 2);
+        Player* p = ps[0];
+        std::vector<Territory*> owned = p->getTerritory();
+
+        std::cout << "[copy] " << owned.size() << " territories owned, orders cycle over them\n";
+        for (int n = 1000; n <= 1000000; n *= 10) {
+            OrdersList* list = p->getOrder();
+            list->clear();
+            for (int i = 0; i < n; i++) {
+                Territory* t = owned[i % owned.size()];
+                Territory* to = (*t->getAdjacentTerritories())[0];
+                switch (i % 4) {
+                    case 0: list->add(new Deploy(p, t, 3)); break;
+                    case 1: list->add(new Advance(p, to, t, 2)); break;
+                    case 2: list->add(new Airlift(p, to, t, 1)); break;
+                    default: list->add(new Negotiate(p, ps[1])); break;
+                }
+            }
+
+            long long before = heapAllocations.load();
+            Stopwatch sw;
+            OrdersList* copy = new OrdersList(*list);
+            const double listSeconds = sw.seconds();
+            const long long listAllocs = heapAllocations.load() - before;
+            delete copy;
+
+            before = heapAllocations.load();
+            Stopwatch sw2;
+            Player* clone = new Player(*p);
+            const double playerSeconds = sw2.seconds();
+            const long long playerAllocs = heapAllocations.load() - before;
+            delete clone;
+
+            std::cout << "  " << n << " orders: OrdersList copy " << listSeconds * 1000.0 << " ms ("
+                      << listSeconds * 1e9 / n << " ns/order, "
+                      << (double)listAllocs / n << " allocs/order), Player copy "
+                      << playerSeconds * 1000.0 << " ms (" << playerAllocs << " allocs)\n";
+        }
+
+        for (auto* pl : ps) delete pl;
+        delete m;
+    }
+
+    // --------------------------------------------------------------------
+    // schedule: reordering and round sequencing, OrdersList vs OrderScheduler
+    // --------------------------------------------------------------------
+
+    void benchSchedule() {
+        Map* m = buildGridMap(200, 100, 16, 4);
+        m->buildAdjacencyIndex();
+        std::vector<Player*> ps = makeGridPlayers(m, 4);
+        Player* p = ps[0];
+        std::vector<Territory*> owned = p->getTerritory();
+        const int ops = 2000;
+
+        std::cout << "[schedule] " << ops << " moves + " << ops << " removes on one player's list\n";
+        for (int n = 10000; n <= 100000; n *= 10) {
+            // vector list: move() finds both orders by scanning, remove() scans + erases
+            OrdersList list;
+            std::vector<Orders*> issued;
+            for (int i = 0; i < n; i++) {
+                Territory* t = owned[i % owned.size()];
+                issued.push_back(new Advance(p, (*t->getAdjacentTerritories())[0], t, 1));
+                list.add(issued.back());
+            }
+            std::mt19937 pick(11);
+            Stopwatch sw;
+            for (int k = 0; k < ops; k++) list.move(issued[pick() % n], issued[pick() % n]);
+            for (int k = 0; k < ops; k++) {
+                const int victim = pick() % n;
+                if (issued[victim] == nullptr) continue;
+                list.remove(issued[victim]);
+                issued[victim] = nullptr;
+            }
+            const double listSeconds = sw.seconds();
+
+            // scheduler: same operations by handle (all Advances: one queue)
+            OrderScheduler sched(1);
+            std::vector<OrderScheduler::Handle> handles;
+            for (int i = 0; i < n; i++) handles.push_back(sched.add(0, OrderScheduler::OTHER, i));
+            std::mt19937 pick2(11);
+            Stopwatch sw2;
+            for (int k = 0; k < ops; k++) sched.moveBefore(handles[pick2() % n], handles[pick2() % n]);
+            for (int k = 0; k < ops; k++) sched.remove(handles[pick2() % n]);
+            const double schedSeconds = sw2.seconds();
+
+            std::cout << "  " << n << " orders: OrdersList " << listSeconds * 1000.0 << " ms, scheduler "
+                      << schedSeconds * 1000.0 << " ms (" << listSeconds / schedSeconds << "x)\n";
+        }
+
+        // One round's sequence for 4 players x 250k mixed orders
+        const int perPlayer = 250000;
+        OrderScheduler sched(4);
+        std::vector<ScheduledOrder> sequence;
+        static const int levels[] = {OrderScheduler::DEPLOY, OrderScheduler::OTHER,
+                                     OrderScheduler::AIRLIFT, OrderScheduler::OTHER,
+                                     OrderScheduler::BLOCKADE};
+        for (int r = 0; r < 3; r++) {
+            const long long before = heapAllocations.load();
+            Stopwatch sw;
+            sched.reset(4);
+            for (int pl = 0; pl < 4; pl++) {
+                for (int i = 0; i < perPlayer; i++) sched.add(pl, levels[i % 5], i);
+            }
+            sched.merge(sequence);
+            const double seconds = sw.seconds();
+            std::cout << "  sequence round " << r + 1 << ": " << sequence.size() << " orders in "
+                      << seconds * 1000.0 << " ms (" << seconds * 1e9 / sequence.size() << " ns/order, "
+                      << heapAllocations.load() - before << " allocations)\n";
+        }
+
+        for (auto* pl : ps) delete pl;
+        delete m;
+    }
+
+    // --------------------------------------------------------------------
+    // plan: parallel validation + conflict groups for a 1M-order round
+    // --------------------------------------------------------------------
+
+    void benchPlan() {
+        const int players = 8;
+        Map* m = buildGridMap(1000, 500, 16, players);
+        m->buildAdjacencyIndex();
+        std::vector<Player*> ps = makeGridPlayers(m, players);
+        ExecutionContext ctx;
+        ctx.map = m;
+        ctx.players = &ps;
+
+        // Sparse orders: a quarter of the territories each Deploy or Advance,
+        // plus a few Bombs, so the map splits into many independent groups
+        std::mt19937 pick(5);
+        int issued = 0;
+        for (auto* p : ps) {
+            for (auto* t : p->getTerritory()) {
+                const unsigned roll = pick() % 16;
+                if (roll >= 4) continue;
+                auto adj = t->getAdjacentTerritories();
+                Territory* to = (*adj)[pick() % adj->size()];
+                if (roll < 2) p->getOrder()->add(new Deploy(p, t, 2));
+                else if (roll == 2) p->getOrder()->add(new Advance(p, to, t, 1 + t->getArmies() / 2));
+                else p->getOrder()->add(new Bomb(p, to));
+                issued++;
+            }
+        }
+        std::cout << "[plan] " << m->getTerritories()->size() << " territories, " << issued << " orders, "
+                  << players << " players\n";
+
+        RoundPlan plan;
+        double serial = 0.0;
+        for (int threads = 1; threads <= 8; threads *= 2) {
+            ThreadPool pool(threads);
+            Stopwatch sw;
+            plan = planRound(ps, ctx, threads > 1 ? &pool : nullptr);
+            const double seconds = sw.seconds();
+            if (threads == 1) serial = seconds;
+            std::cout << "  " << threads << " thread(s): " << seconds * 1000.0 << " ms ("
+                      << serial / seconds << "x)\n";
+        }
+
+        int largest = 0;
+        for (int g = 0; g < plan.groups; g++) {
+            largest = std::max(largest, plan.groupOffsets[g + 1] - plan.groupOffsets[g]);
+        }
+        std::cout << "  " << plan.invalid << " invalid at round start, " << plan.conflicts.size()
+                  << " contested territories, " << plan.groups << " groups (largest " << largest << ")\n";
+
+        Stopwatch sw;
+        executeRound(ps, ctx, plan);
+        std::cout << "  executed planned round in " << sw.seconds() * 1000.0 << " ms ("
+                  << ctx.executed << " ok, " << ctx.rejected << " rejected)\n";
+
+        for (auto* p : ps) delete p;
+        delete m;
+    }
+
+    // --------------------------------------------------------------------
+    // truce: "are a and b at truce" checks with 64 players
+    // --------------------------------------------------------------------
+
+    void benchTruce() {
+        const int players = 64;
+        const int checks = 20000000;
+        std::vector<Player*> ps;
+        for (int p = 0; p < players; p++) {
+            ps.push_back(new Player("P" + std::to_string(p), std::vector<Territory*>(), new Deck(), new OrdersList()));
+            ps.back()->setId(p);
+        }
+        ExecutionContext ctx;
+        ctx.players = &ps;
+        ctx.beginRound();
+
+        // every player negotiates once: up to 64 truces this round
+        std::mt19937 pick(9);
+        std::vector<std::pair<const Player*, const Player*>> pairs;   // the old representation
+        for (int p = 0; p < players; p++) {
+            int other = pick() % players;
+            if (other == p) other = (other + 1) % players;
+            Negotiate(ps[p], ps[other]).execute(ctx);
+            pairs.push_back(std::make_pair(ps[p], ps[other]));
+        }
+
+        std::vector<int> queries(2 * 4096);
+        for (auto& q : queries) q = pick() % players;
+
+        Stopwatch sw;
+        long long hitsScan = 0;
+        for (int i = 0; i < checks; i++) {
+            const Player* a = ps[queries[(2 * i) & 8191]];
+            const Player* b = ps[queries[(2 * i + 1) & 8191]];
+            for (const auto& t : pairs) {
+                if ((t.first == a && t.second == b) || (t.first == b && t.second == a)) {
+                    hitsScan++;
+                    break;
+                }
+            }
+        }
+        const double scanSeconds = sw.seconds();
+
+        Stopwatch sw2;
+        long long hitsTable = 0;
+        for (int i = 0; i < checks; i++) {
+            hitsTable += ctx.atTruce(ps[queries[(2 * i) & 8191]], ps[queries[(2 * i + 1) & 8191]]);
+        }
+        const double tableSeconds = sw2.seconds();
+
+        Stopwatch sw3;
+        const int rounds = 100000;
+        for (int r = 0; r < rounds; r++) {
+            ctx.truces.add(r % players, (r * 7 + 1) % players);
+            ctx.beginRound();
+        }
+        const double clearSeconds = sw3.seconds();
+
+        std::cout << "[truce] " << players << " players, " << pairs.size() << " negotiations, "
+                  << checks / 1000000 << "M checks\n";
+        std::cout << "  pair list scan : " << scanSeconds * 1000.0 << " ms (" << hitsScan << " at truce)\n";
+        std::cout << "  truce table    : " << tableSeconds * 1000.0 << " ms (" << hitsTable << " at truce, "
+                  << scanSeconds / tableSeconds << "x)\n";
+        std::cout << "  add + new round: " << clearSeconds * 1e9 / rounds << " ns\n";
+
+        for (auto* p : ps) delete p;
+    }
+
+    // --------------------------------------------------------------------
+    // ownership: toDefend/toAttack by scan vs. the map's OwnershipIndex
+    // --------------------------------------------------------------------
+
+    void benchOwnership() {
+        const int players = 8;
+        Map* m = buildGridMap(1000, 500, 16, players);
+        m->buildAdjacencyIndex();
+        std::vector<Player*> ps = makeGridPlayers(m, players);
+        std::vector<Territory*>& all = *m->getTerritories();
+        const int queries = 20;
+
+        // scan: every query walks the player's list (and its neighbors)
+        Stopwatch sw;
+        std::size_t scanned = 0;
+        for (int q = 0; q < queries; q++) {
+            for (auto* p : ps) scanned += p->toDefend().size() + p->toAttack().size();
+        }
+        const double scanSeconds = sw.seconds();
+
+        for (auto* p : ps) p->setMap(m);
+        Stopwatch build;
+        m->getOwnership();
+        const double buildSeconds = build.seconds();
+
+        Stopwatch sw2;
+        std::size_t indexed = 0;
+        for (int q = 0; q < queries; q++) {
+            for (auto* p : ps) indexed += p->toDefend().size() + p->toAttack().size();
+        }
+        const double indexSeconds = sw2.seconds();
+
+        // ownership churn with the index live (every change updates it)
+        std::mt19937 pick(3);
+        const int changes = 1000000;
+        std::vector<std::string> names;
+        for (auto* p : ps) names.push_back(p->getPName());
+        Stopwatch sw3;
+        for (int i = 0; i < changes; i++) all[pick() % all.size()]->setOwner(names[pick() % players]);
+        const double churnSeconds = sw3.seconds();
+
+        Stopwatch sw4;
+        std::size_t frontier = 0;
+        for (auto* p : ps) frontier += p->toAttack().size();
+        const double afterSeconds = sw4.seconds();
+
+        std::cout << "[ownership] " << all.size() << " territories, " << players << " players, "
+                  << queries << " rounds of toDefend+toAttack for everyone\n";
+        std::cout << "  scan   : " << scanSeconds * 1000.0 << " ms (" << scanned << " territories returned)\n";
+        std::cout << "  index  : " << indexSeconds * 1000.0 << " ms (" << indexed << " returned, "
+                  << scanSeconds / indexSeconds << "x), built once in " << buildSeconds * 1000.0 << " ms\n";
+        std::cout << "  " << changes << " ownership changes with the index live: "
+                  << churnSeconds * 1e9 / changes << " ns each\n";
+        std::cout << "  toAttack for everyone afterwards: " << afterSeconds * 1000.0 << " ms ("
+                  << frontier << " frontier territories)\n";
+
+        for (auto* p : ps) delete p;
+        delete m;
+    }
+
+    // --------------------------------------------------------------------
+    // ownerids: "who owns this" by name vs by integer player id
+    // --------------------------------------------------------------------
+
+    void benchOwnerIds() {
+        const int players = 8;
+        Map* m = buildGridMap(1000, 500, 64, players);
+        m->buildAdjacencyIndex();
+        std::vector<Player*> ps = makeGridPlayers(m, players);
+        TerritoryStore* store = m->getStore();
+        for (auto* p : ps) store->bindPlayer(p->getId(), p->getPName());
+        std::vector<Territory*>& all = *m->getTerritories();
+        std::vector<Continent*>& conts = *m->getContinents();
+        // P0 holds a few whole continents so the bonus checks don't all bail early
+        for (int c = 0; c < 8; c++) {
+            for (auto* t : *conts[c]->getTerritories()) t->setOwnerId(0);
+        }
+        const int reps = 5;
+
+        // continent bonus: does the player own every territory of the continent?
+        auto bonuses = [&](int mode) {
+            long long held = 0;
+            for (int r = 0; r < reps; r++) {
+                for (auto* p : ps) {
+                    const std::string name = p->getPName();
+                    const int id = p->getId();
+                    for (auto* c : conts) {
+                        bool whole = true;
+                        for (auto* t : *c->getTerritories()) {
+                            const bool mine = mode == 0 ? t->getOwner() == name
+                                            : mode == 1 ? t->isOwnedBy(name)
+                                            : t->getOwnerId() == id;
+                            if (!mine) { whole = false; break; }
+                        }
+                        held += whole;
+                    }
+                }
+            }
+            return held;
+        };
+        // frontier: enemy neighbors of every territory the player owns
+        auto frontier = [&](int mode) {
+            long long edges = 0;
+            for (auto* p : ps) {
+                const std::string name = p->getPName();
+                const int id = p->getId();
+                for (auto* t : all) {
+                    const bool mine = mode == 0 ? t->getOwner() == name
+                                    : mode == 1 ? t->isOwnedBy(name)
+                                    : t->getOwnerId() == id;
+                    if (!mine) continue;
+                    for (int n : m->neighbors(t->getIndex())) {
+                        const Territory* other = all[n];
+                        edges += mode == 0 ? other->getOwner() != name
+                               : mode == 1 ? !other->isOwnedBy(name)
+                               : other->getOwnerId() != id;
+                    }
+                }
+            }
+            return edges;
+        };
+
+        const char* labels[] = {"getOwner() == name", "isOwnedBy(name)   ", "getOwnerId() == id"};
+        double bonusSeconds[3], frontierSeconds[3];
+        long long bonusHeld[3], frontierEdges[3];
+        for (int mode = 0; mode < 3; mode++) {
+            Stopwatch sw;
+            bonusHeld[mode] = bonuses(mode);
+            bonusSeconds[mode] = sw.seconds();
+            Stopwatch sw2;
+            frontierEdges[mode] = frontier(mode);
+            frontierSeconds[mode] = sw2.seconds();
+        }
+
+        // resolving a territory's owner back to a Player, as order execution does
+        ExecutionContext ctx;
+        ctx.map = m;
+        ctx.players = &ps;
+        Stopwatch sw3;
+        long long found = 0;
+        for (auto* t : all) found += ctx.ownerOf(t) != nullptr;
+        const double idLookup = sw3.seconds();
+        store->unbindPlayers();
+        Stopwatch sw4;
+        long long foundByName = 0;
+        for (auto* t : all) foundByName += ctx.ownerOf(t) != nullptr;
+        const double nameLookup = sw4.seconds();
+
+        std::cout << "[ownerids] " << all.size() << " territories, " << conts.size() << " continents, "
+                  << players << " players\n";
+        for (int mode = 0; mode < 3; mode++) {
+            std::cout << "  " << labels[mode] << ": bonus checks " << bonusSeconds[mode] * 1000.0 / reps
+                      << " ms/round (" << bonusHeld[mode] / reps << " held), frontier "
+                      << frontierSeconds[mode] * 1000.0 << " ms (" << frontierEdges[mode] << " edges)\n";
+        }
+        std::cout << "  bonus speedup by id: " << bonusSeconds[0] / bonusSeconds[2] << "x vs getOwner, "
+                  << bonusSeconds[1] / bonusSeconds[2] << "x vs isOwnedBy\n";
+        std::cout << "  owner -> Player for every territory: by name " << nameLookup * 1000.0
+                  << " ms, by id " << idLookup * 1000.0 << " ms (" << nameLookup / idLookup << "x)"
+                  << (found == foundByName ? "" : "  MISMATCH") << "\n";
+
+        for (auto* p : ps) delete p;
+        delete m;
+    }
+
+    // --------------------------------------------------------------------
+    // continents: reinforcement inputs (territory count + continents held)
+    // from the ownership index vs a scan of every continent
+    // --------------------------------------------------------------------
+
+    // One conquest: a random territory goes to the owner of a random neighbor,
+    // so owners grow into blobs and continents actually get taken
+    void conquer(Map* m, std::mt19937& pick) {
+        std::vector<Territory*>& all = *m->getTerritories();
+        Territory* t = all[pick() % all.size()];
+        NeighborRange nbs = m->neighbors(t->getIndex());
+        if (nbs.empty()) return;
+        t->setOwnerId(all[nbs[pick() % nbs.size()]]->getOwnerId());
+    }
+
+    // The index against a full recount from the store's columns
+    bool matchesRescan(Map* m, const std::vector<Player*>& ps) {
+        TerritoryStore* store = m->getStore();
+        const OwnershipIndex& index = m->getOwnership();
+        const int conts = store->continentCount();
+        std::vector<int> size(conts, 0);
+        std::vector<std::vector<int>> held(ps.size(), std::vector<int>(conts, 0));
+        for (int slot = 0; slot < store->size(); slot++) {
+            const int c = store->getContinents()[slot];
+            size[c]++;
+            const int p = store->playerOf(store->getOwners()[slot]);
+            if (p >= 0) held[p][c]++;
+        }
+        for (auto* p : ps) {
+            const int owner = store->ownerOf(p->getId());
+            int count = 0;
+            std::vector<int> whole;
+            for (int c = 0; c < conts; c++) {
+                if (index.continentSize(c) != size[c] || index.heldIn(owner, c) != held[p->getId()][c]) return false;
+                count += held[p->getId()][c];
+                if (size[c] > 0 && held[p->getId()][c] == size[c]) whole.push_back(c);
+            }
+            std::vector<int> listed = index.controlled(owner);
+            std::sort(listed.begin(), listed.end());
+            if (listed != whole || p->territoryCount() != count) return false;
+        }
+        return true;
+    }
+
+    void benchContinents() {
+        const int players = 6;
+        Map* m = buildGridMap(10, 10000, 10000, players);   // 10000 continents of 10
+        m->buildAdjacencyIndex();
+        std::vector<Player*> ps = makeGridPlayers(m, players);
+        TerritoryStore* store = m->getStore();
+        for (auto* p : ps) {
+            store->bindPlayer(p->getId(), p->getPName());
+            p->setMap(m);
+        }
+        std::vector<Continent*>& conts = *m->getContinents();
+        std::mt19937 pick(11);
+        for (int i = 0; i < 2000000; i++) conquer(m, pick);   // let blobs form before the index exists
+
+        // naive: every player scans every continent's territories
+        const int turns = 20;
+        Stopwatch sw;
+        long long naive = 0;
+        for (int turn = 0; turn < turns; turn++) {
+            for (auto* p : ps) {
+                int count = 0;
+                int whole = 0;
+                for (auto* c : conts) {
+                    int mine = 0;
+                    for (auto* t : *c->getTerritories()) mine += t->getOwnerId() == p->getId();
+                    count += mine;
+                    whole += mine == (int)c->getTerritories()->size();
+                }
+                naive += std::max(3, count / 3) + whole;
+            }
+        }
+        const double naiveSeconds = sw.seconds();
+
+        Stopwatch build;
+        m->getOwnership();
+        const double buildSeconds = build.seconds();
+
+        Stopwatch sw2;
+        long long indexed = 0;
+        for (int turn = 0; turn < turns; turn++) {
+            for (auto* p : ps) {
+                const int owner = store->ownerOf(p->getId());
+                indexed += std::max(3, (int)m->getOwnership().owned(owner).size() / 3)
+                         + (int)m->getOwnership().controlled(owner).size();
+            }
+        }
+        const double indexSeconds = sw2.seconds();
+
+        // randomized churn (conquests plus the odd territory moving continent),
+        // checked against a full recount every so often
+        const int rounds = 200;
+        const int changesPerRound = 2000;
+        bool ok = matchesRescan(m, ps);
+        std::vector<Territory*>& all = *m->getTerritories();
+        Stopwatch sw3;
+        for (int r = 0; r < rounds && ok; r++) {
+            for (int i = 0; i < changesPerRound; i++) {
+                if (i % 100 == 0) {
+                    all[pick() % all.size()]->setContinent(conts[pick() % conts.size()]->getName());
+                } else {
+                    conquer(m, pick);
+                }
+            }
+            ok = matchesRescan(m, ps);
+        }
+        const double churnSeconds = sw3.seconds();
+
+        std::size_t held = 0;
+        for (auto* p : ps) held += p->controlledContinents().size();
+
+        std::cout << "[continents] " << all.size() << " territories, " << conts.size() << " continents, "
+                  << players << " players, " << turns << " reinforcement passes\n";
+        std::cout << "  scan  : " << naiveSeconds * 1000.0 / turns << " ms/pass\n";
+        std::cout << "  index : " << indexSeconds * 1e6 / turns << " us/pass ("
+                  << naiveSeconds / indexSeconds << "x), built once in " << buildSeconds * 1000.0 << " ms"
+                  << (naive == indexed ? "" : "  MISMATCH") << "\n";
+        std::cout << "  " << rounds * changesPerRound << " random changes, recounted every " << changesPerRound
+                  << " (" << churnSeconds * 1000.0 << " ms incl. recounts): " << (ok ? "ok" : "FAILED")
+                  << ", " << held << " continents held at the end\n";
+
+        for (auto* p : ps) delete p;
+        delete m;
+    }
+
+    // --------------------------------------------------------------------
+    // simulate: whole headless games (GameEngine::simulate)
+    // --------------------------------------------------------------------
+
+    void benchSimulate() {
+        const int players = 4;
+        Map* m = buildGridMap(30, 30, 9, players);
+        m->buildAdjacencyIndex();
+        const int games = 200;
+
+        Stopwatch sw;
+        long long turns = 0;
+        long long orders = 0;
+        int limited = 0;
+        std::vector<int> wins(players, 0);
+        for (int g = 0; g < games; g++) {
+            SimulationResult r = GameEngine::simulate(1000 + g, *m, players);
+            turns += r.turns;
+            orders += r.ordersExecuted;
+            if (r.winner >= 0) wins[r.winner]++;
+            else limited++;
+        }
+        const double seconds = sw.seconds();
+
+        // a seed replays its game
+        SimulationResult a = GameEngine::simulate(1007, *m, players);
+        SimulationResult b = GameEngine::simulate(1007, *m, players);
+        const bool replay = a.winner == b.winner && a.turns == b.turns && a.battles == b.battles
+                         && a.territories == b.territories;
+        // planned rounds: the same game whether validation runs on one
+        // thread or several
+        ThreadPool one(1), three(3);
+        Stopwatch planned;
+        SimulationResult c = GameEngine::simulate(1007, *m, players, 1000, &one);
+        const double plannedMs = planned.seconds() * 1000.0;
+        SimulationResult d = GameEngine::simulate(1007, *m, players, 1000, &three);
+        const bool pooled = c.winner == d.winner && c.turns == d.turns && c.battles == d.battles
+                         && c.territories == d.territories;
+
+        std::cout << "[simulate] " << games << " games, " << m->getTerritories()->size()
+                  << " territories, " << players << " players\n";
+        std::cout << "  " << games / seconds << " games/s, " << turns / seconds << " turns/s ("
+                  << (double)turns / games << " turns/game, " << orders / seconds << " orders/s)\n";
+        std::cout << "  wins:";
+        for (int p = 0; p < players; p++) std::cout << " P" << p << "=" << wins[p];
+        std::cout << ", turn limit=" << limited << "\n";
+        std::cout << "  same seed, same game: " << (replay ? "ok" : "FAILED")
+                  << ", planned rounds on 1 or 3 threads: " << (pooled ? "ok" : "FAILED")
+                  << " (" << c.turns << " turns in " << plannedMs << " ms)\n";
+
+        delete m;
+    }
+
+    // --------------------------------------------------------------------
+    // topology: a new game's map, deep copy vs shared topology + state
+    // --------------------------------------------------------------------
+
+    // Every border and continent member of m points at one of m's own territories
+    bool selfContained(const Map& m) {
+        const TerritoryStore* store = m.getStore();
+        for (auto t : *m.getTerritories()) {
+            for (auto nb : *t->getAdjacentTerritories()) {
+                if (nb->getStore() != store) return false;
+            }
+        }
+        for (auto c : *m.getContinents()) {
+            for (auto t : *c->getTerritories()) {
+                if (t->getStore() != store) return false;
+            }
+        }
+        return true;
+    }
+
+    bool sameState(const Map& a, const Map& b) {
+        const std::vector<Territory*>& ta = *a.getTerritories();
+        const std::vector<Territory*>& tb = *b.getTerritories();
+        if (ta.size() != tb.size()) return false;
+        for (std::size_t i = 0; i < ta.size(); i++) {
+            if (ta[i]->getId() != tb[i]->getId() || ta[i]->getOwner() != tb[i]->getOwner()
+                || ta[i]->getArmies() != tb[i]->getArmies()) return false;
+        }
+        return true;
+    }
+
+    void benchTopology() {
+        const int players = 4;
+        Map* m = buildGridMap(200, 100, 16, players);
+        m->buildAdjacencyIndex();
+        const int n = (int)m->getTerritories()->size();
+        const int reps = 20;
+
+        auto time = [&](const char* label, auto once) {
+            const long long before = heapAllocations.load();
+            Stopwatch sw;
+            for (int r = 0; r < reps; r++) once();
+            const double ms = sw.seconds() * 1000.0 / reps;
+            const double allocs = (double)(heapAllocations.load() - before) / reps;
+            std::cout << "  " << label << ms << " ms, " << allocs << " allocs\n";
+            return ms;
+        };
+
+        std::cout << "[topology] " << n << " territories, " << m->getContinents()->size()
+                  << " continents, per new game (mean of " << reps << ")\n";
+        // what a copy used to be: every Territory and Continent copied one by
+        // one, borders still pointing into the original
+        const double deep = time("per-territory deep copy   ", [&] {
+            Map legacy(m->getTerritories(), m->getContinents());
+        });
+        time("Map copy (takes topology) ", [&] { Map copy(*m); });
+
+        std::shared_ptr<const MapTopology> topo;
+        time("topology() snapshot       ", [&] { topo = m->topology(); });
+        MapState start = m->saveState();
+        time("Map(topology, state)      ", [&] { Map board(topo, start); });
+        time("saveState()               ", [&] { MapState s = m->saveState(); });
+
+        Map board(topo, start);
+        board.getOwnership();   // reset has to keep a built index in step
+        const double reset = time("loadState() on a board    ", [&] { board.loadState(start); });
+        std::cout << "  reset vs deep copy: " << deep / reset << "x\n";
+
+        // copies own their graph; copies of a board share its topology
+        Map copy(*m);
+        Map second(board);
+        const bool contained = selfContained(copy) && selfContained(board) && selfContained(second);
+        const bool shared = second.topology() == topo && board.topology() == topo;
+
+        // play on the board, then reset it: same state as the original, and
+        // the ownership index agrees with a rescan
+        TerritoryStore* store = board.getStore();
+        std::mt19937 rng(23);
+        for (int k = 0; k < n; k++) {
+            store->setOwner((int)(rng() % n), store->internOwner("P" + std::to_string(rng() % players)));
+            store->setArmies((int)(rng() % n), (int)(rng() % 50));
+        }
+        board.loadState(start);
+        bool restored = sameState(board, *m);
+        const OwnershipIndex& index = board.getOwnership();
+        for (int p = 0; p < players && restored; p++) {
+            const int owner = store->findOwner("P" + std::to_string(p));
+            int count = 0;
+            for (int slot = 0; slot < n; slot++) count += store->getOwners()[slot] == owner;
+            restored = (int)index.owned(owner).size() == count;
+        }
+
+        // an edited board stops handing out the shared topology
+        std::vector<Territory*> none;
+        board.addContinent(new Continent("Extra", 1000, &none));
+        const bool dropped = board.topology() != topo
+                          && board.topology()->continents().size() == topo->continents().size() + 1;
+
+        std::cout << "  copies self-contained: " << (contained ? "ok" : "FAILED")
+                  << ", topology shared: " << (shared ? "ok" : "FAILED")
+                  << ", reset restores state: " << (restored ? "ok" : "FAILED")
+                  << ", edit drops it: " << (dropped ? "ok" : "FAILED") << "\n";
+        delete m;
+    }
+
+    // --------------------------------------------------------------------
+    // undo: try an order set and take it back, journal vs snapshot vs copy
+    // --------------------------------------------------------------------
+
+    // Players' holdings as sorted slots (lists get territories back at the end)
+    std::vector<std::vector<int>> holdingSets(const std::vector<Player*>& ps) {
+        std::vector<std::vector<int>> sets;
+        for (auto* p : ps) {
+            std::vector<int> slots;
+            for (auto* t : p->getTerritory()) slots.push_back(t->getIndex());
+            std::sort(slots.begin(), slots.end());
+            sets.push_back(slots);
+        }
+        return sets;
+    }
+
+    void benchUndo() {
+        const int players = 4;
+        const int attacks = 32;     // what-if orders per trial: a Deploy + an Advance each
+        const int cycles = 20000;
+        Map* m = buildGridMap(100, 100, 16, players);
+        m->buildAdjacencyIndex();
+        std::vector<Player*> ps = makeGridPlayers(m, players, OrdersStorage::Records);
+        TerritoryStore* store = m->getStore();
+        for (auto* p : ps) store->bindPlayer(p->getId(), p->getPName());
+
+        ExecutionContext ctx;
+        ctx.map = m;
+        ctx.players = &ps;
+        ctx.combat.setSeed(24);
+
+        const MapState start = m->saveState();
+        const std::vector<std::vector<int>> holdings = holdingSets(ps);
+        std::vector<Territory*> mine = ps[0]->getTerritory();
+        std::mt19937 pick(5);
+        auto trial = [&] {
+            OrdersList* list = ps[0]->getOrder();
+            for (int a = 0; a < attacks; a++) {
+                Territory* t = mine[pick() % mine.size()];
+                auto adj = t->getAdjacentTerritories();
+                Territory* to = (*adj)[pick() % adj->size()];
+                list->addRecord(OrderRecord{OrderKind::Deploy, 0, t->getIndex(), -1, 10});
+                list->addRecord(OrderRecord{OrderKind::Advance, 0, to->getIndex(), t->getIndex(), 10});
+            }
+            executeRound(ps, ctx);
+        };
+
+        // journal: O(changes) per undo
+        StateJournal journal;
+        store->setJournal(&journal);
+        long long changes = 0;
+        Stopwatch sw;
+        for (int c = 0; c < cycles; c++) {
+            const StateJournal::Mark mark = journal.mark();
+            trial();
+            changes += journal.size() - mark;
+            ctx.rollback(journal, mark);
+        }
+        const double journalSeconds = sw.seconds();
+        store->setJournal(nullptr);
+        const bool journalOk = m->saveState().owners == start.owners
+                            && m->saveState().armies == start.armies && holdingSets(ps) == holdings;
+
+        // snapshot: O(map) per undo
+        const int snapCycles = cycles / 20;
+        const GameSnapshot snap = ctx.snapshot();
+        Stopwatch sw2;
+        for (int c = 0; c < snapCycles; c++) {
+            trial();
+            ctx.restore(snap);
+        }
+        const double snapSeconds = sw2.seconds();
+        const bool snapOk = m->saveState().owners == start.owners && m->saveState().armies == start.armies
+                         && holdingSets(ps) == holdings;
+
+        // what a trial used to need: a copy of the Map and every Player
+        // (copy alone, nothing executed on it)
+        const int copyCycles = 20;
+        Stopwatch sw3;
+        for (int c = 0; c < copyCycles; c++) {
+            Map copy(*m);
+            std::vector<Player*> clones;
+            for (auto* p : ps) clones.push_back(new Player(*p));
+            for (auto* p : clones) delete p;
+        }
+        const double copySeconds = sw3.seconds();
+
+        // the ownership index followed every undo
+        const OwnershipIndex& index = m->getOwnership();
+        bool indexOk = true;
+        for (int p = 0; p < players; p++) {
+            indexOk = indexOk && (int)index.owned(store->ownerOf(p)).size() == (int)holdings[p].size();
+        }
+
+        const double perJournal = journalSeconds / cycles;
+        const double perSnap = snapSeconds / snapCycles;
+        const double perCopy = copySeconds / copyCycles;
+        std::cout << "[undo] " << m->getTerritories()->size() << " territories, " << players << " players, "
+                  << attacks * 2 << " orders per trial, " << (double)changes / cycles
+                  << " owner/armies changes per trial\n";
+        std::cout << "  journal rollback : " << 1.0 / perJournal << " apply/undo cycles/s ("
+                  << perJournal * 1e6 << " us/cycle)\n";
+        std::cout << "  snapshot/restore : " << 1.0 / perSnap << " cycles/s (" << perSnap * 1e6 << " us/cycle)\n";
+        std::cout << "  Map+Player copies: " << 1.0 / perCopy << " copies/s (" << perCopy * 1e6
+                  << " us/copy, before executing anything)\n";
+        std::cout << "  state restored: journal " << (journalOk ? "ok" : "FAILED") << ", snapshot "
+                  << (snapOk ? "ok" : "FAILED") << ", ownership index " << (indexOk ? "ok" : "FAILED") << "\n";
+
+        for (auto* p : ps) delete p;
+        delete m;
+    }
+
+    // --------------------------------------------------------------------
+    // mcts: search speed per turn, and games against the built-in policy
+    // --------------------------------------------------------------------
+
+    void benchMcts() {
+        const int players = 4;
+        Map* m = buildGridMap(20, 20, 4, players);
+        m->buildAdjacencyIndex();
+        const MapState start = m->saveState();
+        std::vector<std::string> names;
+        for (int p = 0; p < players; p++) names.push_back("P" + std::to_string(p));
+
+        Map board(m->topology(), start);
+        GameEngine engine;   // after the board: it detaches its journal from it on the way out
+        engine.attach(board, names);
+        Player* searcher = engine.playerById(0);
+
+        // one turn from the opening position, at a 50 ms budget
+        MctsConfig config;
+        config.budgetMs = 50;
+        MctsStrategy* mcts = new MctsStrategy(config);
+        searcher->setStrategy(mcts);
+        std::cout << "[mcts] " << board.getTerritories()->size() << " territories, " << players
+                  << " players, rollout horizon " << config.horizon << " turns\n";
+        for (int turn = 0; turn < 3; turn++) {
+            searcher->issueOrder();
+            const MctsReport& r = mcts->lastSearch();
+            std::cout << "  50 ms turn: " << r.rollouts << " rollouts in " << r.ms << " ms ("
+                      << r.rolloutsPerSecond << " rollouts/s, " << r.threads << " threads), "
+                      << r.plans << " plans, played " << r.chosen << " (mean score " << r.value << ")\n";
+            searcher->getOrder()->clear();
+        }
+
+        // whole games: P0 searches at a 10 ms budget, the others play the policy
+        config.budgetMs = 10;
+        searcher->setStrategy(new MctsStrategy(config));
+        const int games = 6;
+        int wins = 0, limited = 0;
+        long long turns = 0;
+        Stopwatch sw;
+        for (int g = 0; g < games; g++) {
+            engine.resetTo(start);
+            SimulationResult r = engine.playFrom(300 + g, 300);
+            wins += r.winner == 0;
+            limited += r.winner < 0;
+            turns += r.turns;
+        }
+        std::cout << "  " << games << " games at 10 ms/turn: searcher won " << wins << " (policy players would win "
+                  << games / (double)players << " each on average), turn limit " << limited << ", "
+                  << (double)turns / games << " turns/game, " << sw.seconds() << " s\n";
+        delete m;
+    }
+
+    struct Benchmark {
+        const char* name;
+        void (*run)();
+    };
+
+    const Benchmark benchmarks[] = {
+        {"layout", benchLayout},
+        {"adjacency", benchAdjacency},
+        {"load", benchLoad},
+        {"binary", benchBinary},
+        {"scaling", benchScaling},
+        {"validate", benchValidate},
+        {"paths", stressPaths},
+        {"report", benchReport},
+        {"orders", benchOrders},
+        {"combat", benchCombat},
+        {"arena", benchArena},
+        {"copy", benchCopy},
+        {"schedule", benchSchedule},
+        {"plan", benchPlan},
+        {"truce", benchTruce},
+        {"ownership", benchOwnership},
+        {"ownerids", benchOwnerIds},
+        {"continents", benchContinents},
+        {"simulate", benchSimulate},
+        {"topology", benchTopology},
+        {"undo", benchUndo},
+        {"mcts", benchMcts},
+    };
+}
+
+int main(int argc, char** argv) {
+    const char* only = argc > 1 ? argv[1] : nullptr;
+    bool ran = false;
+    for (const auto& b : benchmarks) {
+        if (only && std::strcmp(only, b.name) != 0) continue;
+        b.run();
+        ran = true;
+    }
+    if (!ran) {
+        std::cerr << "Unknown benchmark: " << only << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -4,16 +4,20 @@
 
 #include <algorithm>
 #include <iostream>
+#include <mutex>
 #include <stdexcept>
 #include <random>
 
 // ================= Local Helpers =================
 namespace {
-    // Random generator used for drawing cards at random from the deck
-    std::mt19937& rng() {
+    // Seed for a new deck's generator. Every deck draws from its own
+    // generator, so decks in different games (or threads) never share state;
+    // only this seed source is shared, hence the lock.
+    std::uint32_t freshSeed() {
         static std::random_device rd;
-        static std::mt19937 gen(rd());
-        return gen;
+        static std::mutex lock;
+        std::lock_guard<std::mutex> guard(lock);
+        return rd();
     }
 
     // Helper function to convert enum cardType to a string
@@ -154,10 +158,11 @@ const std::vector<Card*>* Hand::cards() const {
 // ================= Deck =================
 
 // Constructor: allocate a fresh vector of Card*
-Deck::Deck() : cards_(new std::vector<Card*>) {}
+Deck::Deck() : cards_(new std::vector<Card*>), gen_(new std::mt19937(freshSeed())) {}
 
-// Copy constructor: deep copy each card into a new Deck
-Deck::Deck(const Deck& other) : cards_(new std::vector<Card*>) {
+// Copy constructor: deep copy each card into a new Deck (the copy continues
+// the same random sequence)
+Deck::Deck(const Deck& other) : cards_(new std::vector<Card*>), gen_(new std::mt19937(*other.gen_)) {
     cards_->reserve(other.cards_->size());
     for (Card* c : *other.cards_) {
         cards_->push_back(new Card(*c));
@@ -165,7 +170,8 @@ Deck::Deck(const Deck& other) : cards_(new std::vector<Card*>) {
 }
 
 // Construct a Deck from an existing vector of Card*
-Deck::Deck(const std::vector<Card*>& cards) : cards_(new std::vector<Card*>) {
+Deck::Deck(const std::vector<Card*>& cards)
+    : cards_(new std::vector<Card*>), gen_(new std::mt19937(freshSeed())) {
     cards_->reserve(cards.size());
     for (Card* c : cards) {
         cards_->push_back(new Card(*c));
@@ -183,6 +189,7 @@ Deck& Deck::operator=(const Deck& other) {
         for (Card* c : *cards_) delete c;
         delete cards_;
         cards_ = fresh;
+        *gen_ = *other.gen_;
     }
     return *this;
 }
@@ -191,6 +198,7 @@ Deck& Deck::operator=(const Deck& other) {
 Deck::~Deck() {
     for (Card* c : *cards_) delete c;
     delete cards_;
+    delete gen_;
 }
 
 // Draw a card at random from the deck and move ownership to the target Hand
@@ -200,7 +208,7 @@ Card* Deck::draw(Hand& targetHand) {
         return nullptr;
     }
     std::uniform_int_distribution<size_t> dist(0, cards_->size() - 1);
-    size_t idx = dist(rng());
+    size_t idx = dist(*gen_);
 
     Card* picked = cards_->at(idx);
     cards_->erase(cards_->begin() + static_cast<std::ptrdiff_t>(idx));
@@ -209,6 +217,11 @@ Card* Deck::draw(Hand& targetHand) {
     return picked;
 }
 
+// Restart this deck's draws from a fixed seed
+void Deck::seed(std::uint32_t s) {
+    gen_->seed(s);
+}
+
 // Add a card back to the deck
 void Deck::addBack(Card* c) {
     if (c) cards_->push_back(c);
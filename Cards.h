@@ -5,6 +5,8 @@
 #include <string>
 #include <vector>
 #include <cstddef>
+#include <cstdint>
+#include <random>
 
 class Player;
 class Orders;
@@ -40,6 +42,7 @@ public:
 class Deck{
 private:
     std::vector<Card*>* cards_;
+    std::mt19937* gen_;     // this deck's own draws (random seed unless seed() is called)
 
 public:
     Deck();
@@ -49,6 +52,7 @@ public:
     ~Deck();    //Deconstructor
 
     Card* draw(Hand& targetHand);       //removes one random card from the deck and adds it into the target hand
+    void seed(std::uint32_t s);         //makes the draws reproducible (e.g. one stream per game)
     void addBack(Card* C);              //Returns a played card back into the deck
     size_t size() const;
 
@@ -0,0 +1,60 @@
+#ifndef COMBAT_H
+#define COMBAT_H
+
+#include <cstdint>
+#include <vector>
+
+class ThreadPool;
+
+// ============================================================================
+// Combat kernel
+// ============================================================================
+// Resolves Warzone battles: every attacking army kills a defender with 60%
+// probability and every defending army kills an attacker with 70%, all at once.
+//
+// Rolls come from a counter-based generator: roll i of one side of battle b
+// is a hash of (seed, b, side, i), with no generator state in between. A
+// battle's outcome depends only on the seed and its battle number, so batches
+// give the same results whatever the thread count or chunking.
+//  - up to BINOMIAL_CUTOFF armies per side: one hashed roll per army, in a
+//    branch-free loop over 32-bit lanes that the compiler can vectorize
+//  - above that: a single draw from the normal approximation of
+//    Binomial(n, p). At n > 65536 the variance is over 15000, so the
+//    difference from exact rolls is far below one army per hundred.
+
+struct Battle {
+    int attackers = 0;
+    int defenders = 0;
+    // filled in by the kernel
+    int attackersLeft = 0;
+    int defendersLeft = 0;
+};
+
+class CombatKernel {
+private:
+    std::uint64_t seed;
+
+public:
+    static const int BINOMIAL_CUTOFF = 1 << 16;
+    static const std::uint32_t ATTACK_HIT = 2576980378u;   // 0.6 * 2^32
+    static const std::uint32_t DEFEND_HIT = 3006477107u;   // 0.7 * 2^32
+
+    explicit CombatKernel(std::uint64_t seed = 0);
+
+    void setSeed(std::uint64_t s) { seed = s; }
+    std::uint64_t getSeed() const { return seed; }
+
+    // Hits among n rolls that each succeed with probability threshold / 2^32.
+    // side separates the two sides of one battle (0 = attack, 1 = defence).
+    int hits(std::uint64_t battleId, int side, int n, std::uint32_t threshold) const;
+
+    // One battle (fills attackersLeft/defendersLeft)
+    void resolve(Battle& battle, std::uint64_t battleId) const;
+
+    // battles[i] is battle number firstId + i. With a pool, chunks of the batch
+    // run concurrently; results are identical to the serial run.
+    void resolveBatch(std::vector<Battle>& battles, std::uint64_t firstId,
+                      ThreadPool* pool = nullptr) const;
+};
+
+#endif // COMBAT_H
@@ -26,6 +26,11 @@ GameEngine::GameEngine() : state_(GameState::Start) {
     buildTransitions();
 }
 
+GameEngine::~GameEngine() {
+    commit();   // the map may outlive us (simulate's boards)
+    clearPlayers();
+}
+
 /**
  * Return the current state value.
  */
@@ -149,6 +154,21 @@ bool GameEngine::processCommand(const std::string& in) {
     return true;
 }
 
+/**
+ * Applies a transition without running its handler or printing anything.
+ *
+ * @param cmd Command string (already lower-case and trimmed)
+ * @return true if the current state accepts the command.
+ */
+bool GameEngine::step(const std::string& cmd) {
+    const auto itState = transitions_.find(state_);
+    if (itState == transitions_.end()) return false;
+    const auto itCmd = itState->second.find(cmd);
+    if (itCmd == itState->second.end()) return false;
+    state_ = itCmd->second;
+    return true;
+}
+
 /**
  * Show the possible commands from the current state.
  *
@@ -169,6 +189,7 @@ std::vector<std::string> GameEngine::availableCommands() const {
  */
 void GameEngine::onLoadMap() {
     const std::string path = "sample.map";
+    commit();   // checkpoints belong to the old map
     const bool ok = loader_.loadMap(path);
     map_ = loader_.getMap();
     std::cout << (ok && map_ ? "[loadmap] Loaded " + path : "[loadmap] Failed to load " + path) << "\n";
@@ -194,6 +215,8 @@ void GameEngine::onValidateMap() {
 void GameEngine::clearPlayers() {
     for (auto* p : players_) delete p;
     players_.clear();
+    delete neutral_;
+    neutral_ = nullptr;
 }
 
 /**
@@ -201,16 +224,29 @@ void GameEngine::clearPlayers() {
  *
  */
 void GameEngine::onAddPlayer() {
+    createPlayers({"Alice", "Bob"}, OrdersStorage::Objects);
+    std::cout << "[addplayer] Created " << players_.size() << " players.\n";
+}
+
+/**
+ * Replaces the players with one per name, plus Neutral.
+ *
+ * @param names Player names, in id order
+ * @param storage Storage mode of every player's OrdersList
+ */
+void GameEngine::createPlayers(const std::vector<std::string>& names, OrdersStorage storage) {
     clearPlayers();
 
     std::vector<Territory*> none;
-    Deck* d = new Deck();              // FIX: allocate pointer
-    OrdersList* ol = new OrdersList(); // FIX: allocate pointer
-
-    players_.push_back(new Player("Alice", none, d, ol));
-    players_.push_back(new Player("Bob",   none, d, ol));
-
-    std::cout << "[addplayer] Created " << players_.size() << " players.\n";
+    // Each player owns its Deck and OrdersList (~Player deletes both)
+    for (const auto& name : names) {
+        players_.push_back(new Player(name, none, new Deck(), new OrdersList(storage)));
+    }
+    neutral_ = new Player("Neutral", none, new Deck(), new OrdersList(storage));
+    // ids index players_ (OrderRecord::player); Neutral never issues orders
+    // and takes the id after the last player
+    for (size_t i = 0; i < players_.size(); i++) players_[i]->setId((int)i);
+    neutral_->setId((int)players_.size());
 }
 
 /**
@@ -219,19 +255,50 @@ void GameEngine::onAddPlayer() {
  */
 void GameEngine::distributeRoundRobin() {
     if (!map_) return;
-    auto* terrs = map_->getTerritories();
+    const Map& board = *map_;   // read-only access keeps the map's ID indexes
+    const std::vector<Territory*>* terrs = board.getTerritories();
     if (!terrs || terrs->empty() || players_.empty()) return;
 
+    bindPlayers();
+
     size_t pi = 0;
     for (auto* t : *terrs) {
-        t->setOwner(players_[pi]->getPName());
-        auto v = players_[pi]->getTerritory();
-        v.push_back(t);
-        players_[pi]->setTerritory(v);
+        t->setOwnerId(players_[pi]->getId());
+        players_[pi]->addTerritory(t);
         pi = (pi + 1) % players_.size();
     }
 }
 
+/**
+ * Registers every player (and Neutral) with the current map by id.
+ *
+ */
+void GameEngine::bindPlayers() {
+    if (!map_) return;
+    TerritoryStore* store = map_->getStore();
+    store->unbindPlayers();
+    for (auto* p : players_) {
+        store->bindPlayer(p->getId(), p->getPName());
+        // players answer toDefend/toAttack from the map's ownership index
+        p->setMap(map_);
+    }
+    if (neutral_) {
+        store->bindPlayer(neutral_->getId(), neutral_->getPName());
+        neutral_->setMap(map_);
+    }
+}
+
+/**
+ * Looks a player up by id (Neutral included).
+ *
+ * @return the player, or nullptr if the id is unknown.
+ */
+Player* GameEngine::playerById(int id) const {
+    if (id >= 0 && id < (int)players_.size()) return players_[id];
+    if (neutral_ && id == neutral_->getId()) return neutral_;
+    return nullptr;
+}
+
 /**
  * Handles the "assigncountries" command.
  *
@@ -258,8 +325,7 @@ void GameEngine::onIssueOrder() {
         auto owned = p->getTerritory();
         if (owned.empty()) continue;
 
-        int* one = new int(1);
-        Orders* o = new Deploy(p, owned.front(), one);
+        Orders* o = new Deploy(p, owned.front(), 1);
 
         OrdersList* ol = p->getOrder();   // FIX: pointer
         ol->add(o);                       // FIX: call on pointer
@@ -283,7 +349,86 @@ void GameEngine::onEndIssueOrders() {
  *
  */
 void GameEngine::onEndExecOrders() {
-    std::cout << "[endexecorders] Execution completed (placeholder). Returning to reinforcement.\n";
+    executeOrders();
+    std::cout << "[endexecorders] Executed " << exec_.executed << " orders ("
+              << exec_.rejected << " rejected). Returning to reinforcement.\n";
+}
+
+/**
+ * Runs every player's orders once (priority order, round-robin inside each level) against the map.
+ *
+ * @return number of orders that were valid and applied.
+ */
+int GameEngine::executeOrders() {
+    bindContext();
+    if (!plannedRounds_) return executeRound(players_, exec_);
+    const RoundPlan plan = planRound(players_, exec_, planPool_);
+    return executeRound(players_, exec_, plan);
+}
+
+/**
+ * Switches executeOrders between the plain pass and the round planner.
+ *
+ * @param on Plan every round before executing it
+ * @param pool Validates the planned rounds (nullptr: on the calling thread)
+ */
+void GameEngine::usePlannedRounds(bool on, ThreadPool* pool) {
+    plannedRounds_ = on;
+    planPool_ = on ? pool : nullptr;
+}
+
+void GameEngine::bindContext() {
+    exec_.map = map_;
+    exec_.players = &players_;
+    exec_.neutral = neutral_;
+}
+
+/**
+ * Copies the mutable game state (owners, armies, players' territories).
+ *
+ * @return a snapshot for restore().
+ */
+GameSnapshot GameEngine::snapshot() {
+    bindContext();
+    return exec_.snapshot();
+}
+
+/**
+ * Puts the game back to a snapshot. Outstanding checkpoints are dropped.
+ *
+ * @return false if there is no map or its territories changed since.
+ */
+bool GameEngine::restore(const GameSnapshot& s) {
+    bindContext();
+    return exec_.restore(s);
+}
+
+/**
+ * Marks the current state; journaling starts with the first checkpoint.
+ *
+ * @return the mark to roll back to.
+ */
+StateJournal::Mark GameEngine::checkpoint() {
+    if (!map_) return 0;
+    map_->getStore()->setJournal(&journal_);
+    return journal_.mark();
+}
+
+/**
+ * Undoes every owner/armies change since mark, in O(changes).
+ */
+void GameEngine::rollback(StateJournal::Mark mark) {
+    if (!map_ || map_->getStore()->getJournal() != &journal_) return;
+    bindContext();
+    exec_.rollback(journal_, mark);
+}
+
+/**
+ * Keeps the current state: forgets every checkpoint and stops journaling.
+ */
+void GameEngine::commit() {
+    if (map_ && map_->getStore()->getJournal() == &journal_) map_->getStore()->setJournal(nullptr);
+    journal_.clear();
 }
 
 /**
@@ -309,4 +454,257 @@ void GameEngine::onPlayAgain() {
 void GameEngine::onEnd() {
     std::cout << "[end] Terminating program.\n";
     clearPlayers();
+}
+
+/**
+ * Reinforcements a player receives at the start of a turn.
+ *
+ * @return max(3, territories / 3) plus the bonus of every continent it holds.
+ */
+int GameEngine::reinforcementFor(const Player* p) const {
+    if (!map_) return 3;
+    const int owner = map_->getStore()->ownerOf(p->getId());
+    const OwnershipIndex& index = map_->getOwnership();
+    int armies = std::max(3, (int)index.owned(owner).size() / 3);
+    for (int cont : index.controlled(owner)) armies += (index.continentSize(cont) + 1) / 2;
+    return armies;
+}
+
+/**
+ * Orders for every player of a headless game: strategies where players have
+ * one, the built-in policy otherwise. The policy:
+ *  - pairs each of its border territories with its weakest enemy neighbor
+ *  - deploys its reinforcements four at a time on its strongest borders
+ *  - attacks from every border that outnumbers its target, with everything
+ *    but one army
+ *
+ * @param rng The game's generator (order among equally strong borders)
+ * @param fixed Player to skip: its orders are already issued (-1: none)
+ */
+void GameEngine::issueSimulatedOrders(std::mt19937_64& rng, int fixed) {
+    for (auto* p : players_) {
+        if (p->getId() == fixed) continue;   // its orders are already in
+        if (p->getStrategy() != nullptr) {
+            if (p->territoryCount() > 0) p->issueOrder();
+            continue;
+        }
+        issuePolicyOrders(p, rng);
+    }
+}
+
+/**
+ * The built-in policy for one player (see issueSimulatedOrders).
+ *
+ * @param p Player to issue for (nothing if it holds no territory)
+ * @param rng The game's generator
+ */
+void GameEngine::issuePolicyOrders(Player* p, std::mt19937_64& rng) {
+    TerritoryStore* store = map_->getStore();
+    const OwnershipIndex& index = map_->getOwnership();
+    const std::vector<int>& owners = store->getOwners();
+    const std::vector<int>& armies = store->getArmies();
+    const int CHUNK = 4;
+
+    const int owner = store->ownerOf(p->getId());
+    const std::vector<Territory*>& owned = index.owned(owner);
+    if (owned.empty()) return;
+    OrdersList* orders = p->getOrder();
+    int pool = reinforcementFor(p);
+
+    targets_.clear();
+    for (auto* t : owned) {
+        const int slot = t->getIndex();
+        int weakest = -1;
+        for (int nb : store->neighbors(slot)) {
+            if (owners[nb] != owner && (weakest < 0 || armies[nb] < armies[weakest])) weakest = nb;
+        }
+        if (weakest >= 0) targets_.push_back(std::make_pair(slot, weakest));
+    }
+    if (targets_.empty()) {
+        Territory* home = owned[rng() % owned.size()];
+        orders->addRecord(OrderRecord{OrderKind::Deploy, p->getId(), home->getIndex(), -1, pool});
+        return;
+    }
+
+    // strongest borders first; the shuffle breaks ties differently every turn
+    std::shuffle(targets_.begin(), targets_.end(), rng);
+    std::stable_sort(targets_.begin(), targets_.end(),
+                     [&armies](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+                         return armies[a.first] > armies[b.first];
+                     });
+
+    for (std::size_t i = 0; i < targets_.size(); i++) {
+        const int border = targets_[i].first;
+        const int enemy = targets_[i].second;
+        const int deployed = i + 1 == targets_.size() ? pool : std::min(pool, CHUNK);
+        pool -= deployed;
+        if (deployed > 0) {
+            orders->addRecord(OrderRecord{OrderKind::Deploy, p->getId(), border, -1, deployed});
+        }
+        const int attackers = armies[border] + deployed - 1;
+        if (attackers > armies[enemy]) {
+            orders->addRecord(OrderRecord{OrderKind::Advance, p->getId(), enemy, border, attackers});
+        }
+    }
+}
+
+/**
+ * Runs a headless game on this engine (players created, map bound).
+ *
+ * @param seed Seeds combat and the players' choices
+ * @param turnLimit Stop after this many turns without a winner
+ * @return the game's result.
+ */
+SimulationResult GameEngine::play(std::uint64_t seed, int turnLimit) {
+    std::mt19937_64 rng(seed);
+    exec_.combat.setSeed(seed);
+    // decks draw from this game's stream too, not from a shared generator
+    for (auto* p : players_) p->getDeck()->seed((std::uint32_t)rng());
+
+    distributeRoundRobin();
+    step("assigncountries");
+    return playTurns(rng, turnLimit, -1);
+}
+
+/**
+ * Reinforce/issue/execute turns until one player is left or turnLimit.
+ *
+ * @param rng The game's generator
+ * @param turnLimit Stop after this many turns without a winner
+ * @param fixed Player whose first-turn orders are already issued (-1: none)
+ * @return the result of these turns.
+ */
+SimulationResult GameEngine::playTurns(std::mt19937_64& rng, int turnLimit, int fixed) {
+    SimulationResult result;
+    while (result.turns < turnLimit) {
+        issueSimulatedOrders(rng, result.turns == 0 ? fixed : -1);
+        step("issueorder");
+        step("endissueorders");
+        executeOrders();
+        result.ordersExecuted += exec_.executed;
+        result.ordersRejected += exec_.rejected;
+        result.turns++;
+
+        int alive = 0;
+        int last = -1;
+        for (auto* p : players_) {
+            if (p->territoryCount() > 0) {
+                alive++;
+                last = p->getId();
+            }
+        }
+        if (alive <= 1) {
+            result.winner = last;
+            step("win");
+            break;
+        }
+        step("endexecorders");
+    }
+
+    result.battles = exec_.battles;
+    for (auto* p : players_) result.territories.push_back(p->territoryCount());
+    return result;
+}
+
+/**
+ * Sets this engine up on a board that already has owners (see GameEngine.h).
+ *
+ * @param board Map to play on (not owned; must outlive the engine's use of it)
+ * @param names Player names, in id order
+ */
+void GameEngine::attach(Map& board, const std::vector<std::string>& names) {
+    commit();
+    map_ = &board;
+    if (!board.hasAdjacencyIndex()) board.buildAdjacencyIndex();
+    createPlayers(names, OrdersStorage::Records);
+    bindPlayers();
+    syncHoldings();
+    state_ = GameState::AssignReinforcement;
+}
+
+/**
+ * Loads a state into the attached board.
+ *
+ * @return false without a board or if the state is for another map.
+ */
+bool GameEngine::resetTo(const MapState& state) {
+    commit();
+    if (!map_ || !map_->loadState(state)) return false;
+    syncHoldings();
+    return true;
+}
+
+void GameEngine::syncHoldings() {
+    TerritoryStore* store = map_->getStore();
+    const OwnershipIndex& index = map_->getOwnership();
+    for (auto* p : players_) p->setTerritory(index.owned(store->ownerOf(p->getId())));
+    if (neutral_) neutral_->setTerritory(index.owned(store->ownerOf(neutral_->getId())));
+}
+
+/**
+ * Plays on from the board's current state (see GameEngine.h).
+ *
+ * @param seed Seeds combat and the built-in policy
+ * @param turnLimit Stop after this many turns without a winner
+ * @param fixed Player whose first-turn orders are already in its list (-1: none)
+ * @return the result of these turns (winner -1 if nobody won yet).
+ */
+SimulationResult GameEngine::playFrom(std::uint64_t seed, int turnLimit, int fixed) {
+    if (!map_) return SimulationResult();
+    std::mt19937_64 rng(seed);
+    exec_.combat.setSeed(seed);
+    state_ = GameState::AssignReinforcement;
+    return playTurns(rng, turnLimit, fixed);
+}
+
+/**
+ * Plays one complete game without any output (see GameEngine.h).
+ *
+ * @param seed Seeds combat and the players' choices
+ * @param map Map to play on (copied; never modified)
+ * @param players Number of players
+ * @param turnLimit Stop after this many turns without a winner
+ * @param pool Plans every round and validates its orders (nullptr: plain rounds)
+ * @return the game's result.
+ */
+SimulationResult GameEngine::simulate(std::uint64_t seed, const Map& map, int players, int turnLimit,
+                                      ThreadPool* pool) {
+    if (players <= 0) return SimulationResult();
+    Map game(map);
+    return playOn(seed, game, players, turnLimit, pool);
+}
+
+/**
+ * Plays one complete game on a reusable board (see GameEngine.h).
+ *
+ * @param seed Seeds combat and the players' choices
+ * @param board Map to play on; reset to start first
+ * @param start State every game begins from (from board's topology)
+ * @param players Number of players
+ * @param turnLimit Stop after this many turns without a winner
+ * @param pool Plans every round and validates its orders (nullptr: plain rounds)
+ * @return the game's result (empty if start doesn't fit the board).
+ */
+SimulationResult GameEngine::simulate(std::uint64_t seed, Map& board, const MapState& start, int players,
+                                      int turnLimit, ThreadPool* pool) {
+    if (players <= 0 || !board.loadState(start)) return SimulationResult();
+    return playOn(seed, board, players, turnLimit, pool);
+}
+
+// One game on board with a fresh engine (destroyed, players first, before
+// the caller's board)
+SimulationResult GameEngine::playOn(std::uint64_t seed, Map& board, int players, int turnLimit,
+                                    ThreadPool* pool) {
+    if (!board.hasAdjacencyIndex()) board.buildAdjacencyIndex();
+
+    GameEngine engine;
+    engine.map_ = &board;
+    engine.state_ = GameState::MapValidated;   // the caller's map is taken as validated
+    engine.usePlannedRounds(pool != nullptr, pool);
+
+    std::vector<std::string> names;
+    for (int i = 0; i < players; i++) names.push_back("P" + std::to_string(i));
+    engine.createPlayers(names, OrdersStorage::Records);
+    engine.step("addplayer");
+    return engine.play(seed, turnLimit);
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #ifndef GAMEENGINE_H
 #define GAMEENGINE_H
 
+#include <cstdint>
 #include <map>
+#include <random>
 #include <string>
 #include <vector>
 #include "Map.h"
@@ -23,6 +25,17 @@ enum class GameState {
     End
 };
 
+// ================== Simulation result ==================
+// Outcome of one headless game (GameEngine::simulate)
+struct SimulationResult {
+    int winner = -1;                   // player id, -1 if the turn limit came first
+    int turns = 0;                     // full reinforce/issue/execute cycles
+    long long ordersExecuted = 0;
+    long long ordersRejected = 0;
+    unsigned long long battles = 0;
+    std::vector<int> territories;      // per player id, at the end
+};
+
 // ================== GameEngine ==================
 // Controls the main flow of the game and state transitions
 class GameEngine {
@@ -33,6 +46,12 @@ private:
     MapLoader loader_;      // loads maps from file
     Map* map_ = nullptr;    // pointer to the current map
     std::vector<Player*> players_;   // players in the game
+    Player* neutral_ = nullptr;      // owner of blockaded territories
+    ExecutionContext exec_;          // combat kernel + truces for order execution
+    StateJournal journal_;           // undo log while checkpoints are in use (see checkpoint)
+    std::vector<std::pair<int, int>> targets_;   // issueSimulatedOrders scratch: (border, enemy) slots
+    bool plannedRounds_ = false;     // execute through planRound (see usePlannedRounds)
+    ThreadPool* planPool_ = nullptr; // validates the planned rounds; not owned
 
     // Helpers
     static std::string toLower(std::string s);
@@ -41,10 +60,24 @@ private:
     // Internal methods to build and clear state
     void buildTransitions();
     void clearPlayers();
+    void createPlayers(const std::vector<std::string>& names, OrdersStorage storage);
+    bool step(const std::string& cmd);   // transition only: no side effects, no output
+
+    // Headless play (see simulate)
+    SimulationResult play(std::uint64_t seed, int turnLimit);
+    SimulationResult playTurns(std::mt19937_64& rng, int turnLimit, int fixed);
+    static SimulationResult playOn(std::uint64_t seed, Map& board, int players, int turnLimit,
+                                   ThreadPool* pool);
+    void issueSimulatedOrders(std::mt19937_64& rng, int fixed = -1);
+    void syncHoldings();   // players' territory lists from the map's ownership index
+    void bindContext();   // point exec_ at the current map and players
 
 public:
-    // ===== Constructor =====
+    // ===== Constructor & Destructor =====
     GameEngine();
+    GameEngine(const GameEngine& other) = delete;   // owns its players
+    GameEngine& operator=(const GameEngine& other) = delete;
+    ~GameEngine();
 
     // ===== Accessors =====
     std::string stateName() const;       // returns current state's name
@@ -67,8 +100,75 @@ public:
     void onPlayAgain();
     void onEnd();
 
+    // ===== Player registry =====
+    // Ids are positions in players_ (Neutral gets players_.size()).
+    // bindPlayers() ties each id to the map, so territories store and
+    // compare owners as ids; names are only for display.
+    void bindPlayers();
+    Player* playerById(int id) const;   // nullptr if no such player
+
     // ===== Helper =====
     void distributeRoundRobin();
+    int executeOrders();   // one execution pass over every player's orders
+    // Run executeOrders through the round planner: the round's orders are
+    // validated up front (on `pool` if given, not owned), then executed
+    // group by group (see planRound). A round ends on the same map as the
+    // plain pass, but the ownership lists can come out in another order, so
+    // later turns of a seeded game may play out differently.
+    void usePlannedRounds(bool on, ThreadPool* pool = nullptr);
+    // max(3, territories / 3) plus the bonus of every continent held
+    // (maps carry no bonus values yet: half the continent's size, rounded up)
+    int reinforcementFor(const Player* p) const;
+
+    // ===== What-if search =====
+    // Try orders, look at the result, take them back.
+    //  - snapshot()/restore(): the whole game state order execution changes
+    //    (see ExecutionContext::snapshot), by value, O(map)
+    //  - checkpoint(): from the first call on, the map's store journals every
+    //    owner/armies change; rollback(mark) undoes everything since that
+    //    checkpoint in O(changes). Checkpoints nest. commit() keeps the
+    //    current state and stops journaling.
+    //   StateJournal::Mark m = engine.checkpoint();
+    //   ... issue orders, executeOrders(), evaluate ...
+    //   engine.rollback(m);
+    GameSnapshot snapshot();
+    bool restore(const GameSnapshot& s);
+    StateJournal::Mark checkpoint();
+    void rollback(StateJournal::Mark mark);
+    void commit();
+
+    // ===== Playing on from a position =====
+    // attach() makes this a headless engine on `board` (not owned) with one
+    // player per name (ids in that order, Neutral after them), bound to the
+    // owners already on the board. resetTo() loads a state into the board
+    // and drops every checkpoint. playFrom() plays up to turnLimit turns from
+    // the board's current state: players with a strategy are asked
+    // (Player::issueOrder), the others use the built-in policy, and in the
+    // first turn player `fixed` (-1: none) plays the orders already in its
+    // list instead. Search players run their rollouts this way.
+    void attach(Map& board, const std::vector<std::string>& names);
+    bool resetTo(const MapState& state);
+    SimulationResult playFrom(std::uint64_t seed, int turnLimit, int fixed = -1);
+    // The built-in policy's orders for one player, added to its list
+    void issuePolicyOrders(Player* p, std::mt19937_64& rng);
+
+    // ===== Headless simulation =====
+    // Plays a whole game on a private copy of `map` (the caller's map is never
+    // touched) with `players` built-in players, on a fresh engine and without
+    // any output: assign countries, then reinforce/issue/execute until only
+    // one player holds territory (Win) or turnLimit turns have run. Combat
+    // and the players' choices come from `seed`, so a seed replays its game.
+    // With a `pool`, rounds run through the planner (usePlannedRounds) and
+    // validate on it, which pays off on big rounds. A seed replays its game
+    // in either mode. The pool must not be the one running this game: a
+    // worker waiting on its own pool can deadlock it.
+    static SimulationResult simulate(std::uint64_t seed, const Map& map, int players,
+                                     int turnLimit = 1000, ThreadPool* pool = nullptr);
+    // Same game on a board the caller keeps between games (e.g. one per
+    // worker, built from a shared MapTopology): the board is reset to `start`
+    // first, then played on. Cheaper than copying the map for every game.
+    static SimulationResult simulate(std::uint64_t seed, Map& board, const MapState& start, int players,
+                                     int turnLimit = 1000, ThreadPool* pool = nullptr);
 };
 
 #endif // GAMEENGINE_H
\ No newline at end of file
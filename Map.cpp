@@ -1,38 +1,561 @@
 #include "Map.h"
+#include "ThreadPool.h"
 
 #include <iostream>
 #include <string>
 #include <vector>
 #include <algorithm>
-#include <functional>
 #include <fstream>
 #include <sstream>
-#include <map>
 #include <unordered_map>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <functional>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ============================================================================
+// EdgeSet Implementation
+// ============================================================================
+
+void EdgeSet::reset(int edgeCount) {
+    unsigned long long cap = 16;
+    while (cap < (unsigned long long)edgeCount * 2) cap <<= 1;
+    buckets.assign(cap, 0);
+    mask = cap - 1;
+    count = 0;
+}
+
+// Double the table and re-insert (keeps the load factor under 1/2)
+void EdgeSet::grow() {
+    std::vector<unsigned long long> old;
+    old.swap(buckets);
+    unsigned long long cap = old.empty() ? 16 : old.size() * 2;
+    buckets.assign(cap, 0);
+    mask = cap - 1;
+    for (auto k : old) {
+        if (k == 0) continue;
+        unsigned long long i = hash(k) & mask;
+        while (buckets[i] != 0) i = (i + 1) & mask;
+        buckets[i] = k;
+    }
+}
+
+bool EdgeSet::insert(int a, int b) {
+    if ((count + 1) * 2 > buckets.size()) grow();
+    const unsigned long long k = key(a, b);
+    unsigned long long i = hash(k) & mask;
+    while (buckets[i] != 0) {
+        if (buckets[i] == k) return false;
+        i = (i + 1) & mask;
+    }
+    buckets[i] = k;
+    count++;
+    return true;
+}
+
+bool EdgeSet::contains(int a, int b) const {
+    if (buckets.empty()) return false;
+    const unsigned long long k = key(a, b);
+    unsigned long long i = hash(k) & mask;
+    while (buckets[i] != 0) {
+        if (buckets[i] == k) return true;
+        i = (i + 1) & mask;
+    }
+    return false;
+}
+
+
+// ============================================================================
+// TerritoryStore Implementation
+// ============================================================================
+// Slots are kept dense: removing a territory moves the last slot into the hole
+// and rebinds that handle, so scans never have to skip tombstones.
+
+std::atomic<unsigned> TerritoryStore::idVersion(0);
+
+TerritoryStore::TerritoryStore()
+    : topologyVersion(0), adjacencyVersion(0), adjacencyBuilt(false), ownership(nullptr), journal(nullptr) {}
+
+TerritoryStore::~TerritoryStore() {
+    delete ownership;
+}
+
+void TerritoryStore::setOwner(int slot, int ownerIdx) {
+    const int from = owners[slot];
+    if (journal != nullptr && from != ownerIdx) journal->record(StateJournal::Owner, slot, from);
+    owners[slot] = ownerIdx;
+    // a stale index (topology changed since) is rebuilt on its next use instead
+    if (ownership != nullptr && from != ownerIdx && ownership->builtFor(topologyVersion)) {
+        ownership->moved(slot, from, ownerIdx);
+    }
+}
+
+// Swap in a whole owner column (a game reset): one rebuild instead of a
+// moved() per slot
+void TerritoryStore::replaceOwners(std::vector<int> column) {
+    if (column.size() != owners.size()) return;
+    owners.swap(column);
+    if (ownership != nullptr && ownership->builtFor(topologyVersion)) ownership->rebuild(topologyVersion);
+}
+
+void TerritoryStore::undo(const StateJournal::Entry& e) {
+    StateJournal* j = journal;
+    journal = nullptr;
+    if (e.field == StateJournal::Armies) armies[e.slot] = e.value;
+    else setOwner(e.slot, e.value);   // the ownership index follows
+    journal = j;
+}
+
+void TerritoryStore::rollback(StateJournal::Mark mark) {
+    if (journal == nullptr) return;
+    while (journal->size() > mark) {
+        const StateJournal::Entry e = journal->back();
+        journal->pop();
+        undo(e);
+    }
+}
+
+void TerritoryStore::setContinent(int slot, int contIdx) {
+    const int from = continents[slot];
+    continents[slot] = contIdx;
+    if (ownership != nullptr && from != contIdx && ownership->builtFor(topologyVersion)) {
+        ownership->regrouped(slot, from, contIdx);
+    }
+}
+
+const OwnershipIndex& TerritoryStore::ownershipIndex() {
+    ensureAdjacency();
+    if (ownership == nullptr) ownership = new OwnershipIndex(this, topologyVersion);
+    else if (!ownership->builtFor(topologyVersion)) ownership->rebuild(topologyVersion);
+    return *ownership;
+}
+
+int TerritoryStore::append(const std::string& name, const std::string& continent,
+                           const std::string& owner, int armyCount, int id, Territory* handle) {
+    ids.push_back(id);
+    armies.push_back(armyCount);
+    owners.push_back(internOwner(owner));
+    continents.push_back(internContinent(continent));
+    names.push_back(name);
+    handles.push_back(handle);
+    touchTopology();
+    return (int)ids.size() - 1;
+}
+
+void TerritoryStore::release(int slot) {
+    int last = (int)ids.size() - 1;
+    if (slot < 0 || slot > last) return;
+    if (slot != last) {
+        ids[slot] = ids[last];
+        armies[slot] = armies[last];
+        owners[slot] = owners[last];
+        continents[slot] = continents[last];
+        names[slot].swap(names[last]);
+        handles[slot] = handles[last];
+        handles[slot]->slot = slot;
+    }
+    ids.pop_back();
+    armies.pop_back();
+    owners.pop_back();
+    continents.pop_back();
+    names.pop_back();
+    handles.pop_back();
+    touchTopology();
+}
+
+void TerritoryStore::adopt(Territory* t) {
+    if (t->store == this) return;
+    TerritoryStore* old = t->store;
+    int oldSlot = t->slot;
+    int newSlot = append(old->names[oldSlot],
+                         old->continentNames[old->continents[oldSlot]],
+                         old->ownerNames[old->owners[oldSlot]],
+                         old->armies[oldSlot], old->ids[oldSlot], t);
+    if (t->ownsStore) delete old;
+    else old->release(oldSlot);
+    t->store = this;
+    t->slot = newSlot;
+    t->ownsStore = false;
+}
+
+void TerritoryStore::unbindAll() {
+    for (auto h : handles) {
+        h->store = nullptr;
+        h->slot = -1;
+    }
+    ids.clear(); armies.clear(); owners.clear(); continents.clear();
+    names.clear(); handles.clear();
+    touchTopology();
+}
+
+Territory* TerritoryStore::create(const std::string& name, int contIdx, int ownerIdx,
+                                  int armyCount, int id) {
+    ids.push_back(id);
+    armies.push_back(armyCount);
+    owners.push_back(ownerIdx);
+    continents.push_back(contIdx);
+    names.push_back(name);
+    Territory* t = new Territory(this, (int)ids.size() - 1);
+    handles.push_back(t);
+    touchTopology();
+    return t;
+}
+
+int TerritoryStore::internOwner(const std::string& name) {
+    auto it = ownerLookup.find(name);
+    if (it != ownerLookup.end()) return it->second;
+    ownerNames.push_back(name);
+    ownerLookup[name] = (int)ownerNames.size() - 1;
+    return (int)ownerNames.size() - 1;
+}
+
+int TerritoryStore::internContinent(const std::string& name) {
+    auto it = continentLookup.find(name);
+    if (it != continentLookup.end()) return it->second;
+    continentNames.push_back(name);
+    continentLookup[name] = (int)continentNames.size() - 1;
+    return (int)continentNames.size() - 1;
+}
+
+int TerritoryStore::findOwner(const std::string& name) const {
+    auto it = ownerLookup.find(name);
+    return it == ownerLookup.end() ? -1 : it->second;
+}
+
+int TerritoryStore::findContinent(const std::string& name) const {
+    auto it = continentLookup.find(name);
+    return it == continentLookup.end() ? -1 : it->second;
+}
+
+void TerritoryStore::bindPlayer(int playerId, const std::string& name) {
+    if (playerId < 0) return;
+    const int owner = internOwner(name);
+    if (playerId >= (int)ownerOfPlayer.size()) ownerOfPlayer.resize(playerId + 1, -1);
+    if (owner >= (int)playerOfOwner.size()) playerOfOwner.resize(ownerNames.size(), -1);
+    // a rebind drops the old link on either side
+    if (ownerOfPlayer[playerId] >= 0) playerOfOwner[ownerOfPlayer[playerId]] = -1;
+    if (playerOfOwner[owner] >= 0) ownerOfPlayer[playerOfOwner[owner]] = -1;
+    ownerOfPlayer[playerId] = owner;
+    playerOfOwner[owner] = playerId;
+}
+
+void TerritoryStore::unbindPlayers() {
+    playerOfOwner.clear();
+    ownerOfPlayer.clear();
+}
+
+void TerritoryStore::reserve(int n) {
+    ids.reserve(n); armies.reserve(n); owners.reserve(n);
+    continents.reserve(n); names.reserve(n); handles.reserve(n);
+}
+
+bool TerritoryStore::adjacent(int a, int b) const {
+    if (!adjBits.empty()) {
+        unsigned long long bit = (unsigned long long)a * size() + b;
+        return (adjBits[bit >> 6] >> (bit & 63)) & 1ULL;
+    }
+    return adjEdges.contains(a, b);
+}
+
+int TerritoryStore::slotOfName(const std::string& name) const {
+    auto it = nameSlots.find(name);
+    return it == nameSlots.end() ? -1 : it->second;
+}
+
+// Flatten every handle's adjacency vector into one offsets array plus one
+// neighbor-slot array. Neighbors living in another store are skipped.
+void TerritoryStore::buildAdjacency() {
+    const int n = size();
+    adjOffsets.assign(n + 1, 0);
+    for (int i = 0; i < n; i++) {
+        int deg = 0;
+        for (auto nb : *handles[i]->adjacentTerritories) if (nb->store == this) deg++;
+        adjOffsets[i + 1] = adjOffsets[i] + deg;
+    }
+    adjTargets.resize(adjOffsets[n]);
+    for (int i = 0; i < n; i++) {
+        int k = adjOffsets[i];
+        for (auto nb : *handles[i]->adjacentTerritories) {
+            if (nb->store == this) adjTargets[k++] = nb->slot;
+        }
+    }
+
+    // Point-query index on top of the CSR arrays
+    adjBits.clear();
+    adjEdges.clear();
+    if (n <= DENSE_ADJACENCY_LIMIT) {
+        adjBits.assign(((unsigned long long)n * n + 63) / 64, 0);
+        for (int i = 0; i < n; i++) {
+            for (int k = adjOffsets[i]; k < adjOffsets[i + 1]; k++) {
+                unsigned long long bit = (unsigned long long)i * n + adjTargets[k];
+                adjBits[bit >> 6] |= 1ULL << (bit & 63);
+            }
+        }
+    } else {
+        adjEdges.reset((int)adjTargets.size());
+        for (int i = 0; i < n; i++) {
+            for (int k = adjOffsets[i]; k < adjOffsets[i + 1]; k++) adjEdges.insert(i, adjTargets[k]);
+        }
+    }
+
+    nameSlots.clear();
+    nameSlots.reserve(n);
+    for (int i = 0; i < n; i++) {
+        auto res = nameSlots.insert(std::make_pair(names[i], i));
+        if (!res.second) res.first->second = -2;
+    }
+
+    adjacencyVersion = topologyVersion;
+    adjacencyBuilt = true;
+}
+
+
+// ============================================================================
+// OwnershipIndex Implementation
+// ============================================================================
+
+namespace {
+    const std::vector<Territory*> noTerritories;
+    const std::vector<int> noContinents;
+}
+
+OwnershipIndex::OwnershipIndex(const TerritoryStore* s, unsigned v) : store(s), version(v) {
+    rebuild(v);
+}
+
+void OwnershipIndex::rebuild(unsigned v) {
+    version = v;
+    ownedBy.clear();
+    frontierOf.clear();
+    borders.clear();
+    held.clear();
+    controlledBy.clear();
+    continentSizes.clear();
+    controller.clear();
+    controlPos.clear();
+    const int n = store->size();
+    ownedPos.assign(n, -1);
+    const std::vector<int>& owners = store->getOwners();
+    const std::vector<int>& continents = store->getContinents();
+    for (int slot = 0; slot < n; slot++) {
+        const int o = owners[slot];
+        grow(o);
+        ownedPos[slot] = (int)ownedBy[o].size();
+        ownedBy[o].push_back(store->handle(slot));
+        const int c = continents[slot];
+        growContinents(c);
+        continentSizes[c]++;
+        heldBy(o, c)++;
+    }
+    for (int slot = 0; slot < n; slot++) {
+        for (int nb : store->neighbors(slot)) bump(owners[slot], nb, +1);
+    }
+    for (int o = 0; o < (int)held.size(); o++) {
+        for (int c = 0; c < (int)held[o].size(); c++) {
+            if (held[o][c] > 0) settle(c, o);
+        }
+    }
+}
+
+void OwnershipIndex::grow(int owner) {
+    if (owner < (int)ownedBy.size()) return;
+    ownedBy.resize(owner + 1);
+    frontierOf.resize(owner + 1);
+    borders.resize(owner + 1);
+    held.resize(owner + 1);
+    controlledBy.resize(owner + 1);
+}
+
+void OwnershipIndex::growContinents(int cont) {
+    if (cont < (int)continentSizes.size()) return;
+    continentSizes.resize(cont + 1, 0);
+    controller.resize(cont + 1, -1);
+    controlPos.resize(cont + 1, -1);
+}
+
+int& OwnershipIndex::heldBy(int owner, int cont) {
+    std::vector<int>& row = held[owner];
+    if (cont >= (int)row.size()) row.resize(continentSizes.size(), 0);
+    return row[cont];
+}
+
+// Re-check one owner's hold on cont after its count (or nothing else) changed
+void OwnershipIndex::settle(int cont, int owner) {
+    const bool whole = continentSizes[cont] > 0 && heldIn(owner, cont) == continentSizes[cont];
+    if (whole && controller[cont] != owner) {
+        if (controller[cont] >= 0) release(cont);
+        take(cont, owner);
+    } else if (!whole && controller[cont] == owner) {
+        release(cont);
+    }
+}
+
+void OwnershipIndex::take(int cont, int owner) {
+    controller[cont] = owner;
+    controlPos[cont] = (int)controlledBy[owner].size();
+    controlledBy[owner].push_back(cont);
+}
+
+// Swap-remove cont from its controller's list
+void OwnershipIndex::release(int cont) {
+    std::vector<int>& list = controlledBy[controller[cont]];
+    const int last = list.back();
+    list[controlPos[cont]] = last;
+    controlPos[last] = controlPos[cont];
+    list.pop_back();
+    controller[cont] = -1;
+    controlPos[cont] = -1;
+}
+
+std::vector<OwnershipIndex::Border>& OwnershipIndex::bordersOf(int owner) {
+    std::vector<Border>& b = borders[owner];
+    if (b.empty()) b.assign(store->size(), Border{0, -1});
+    return b;
+}
+
+// Append slot to owner's frontier
+void OwnershipIndex::list(int owner, int slot, Border& b) {
+    b.pos = (int)frontierOf[owner].size();
+    frontierOf[owner].push_back(store->handle(slot));
+}
+
+// Swap-remove from owner's frontier
+void OwnershipIndex::unlist(int owner, Border& b) {
+    std::vector<Territory*>& f = frontierOf[owner];
+    Territory* last = f.back();
+    f[b.pos] = last;
+    borders[owner][last->getIndex()].pos = b.pos;
+    f.pop_back();
+    b.pos = -1;
+}
+
+// One more (delta = +1) or one less (-1) of owner's territories borders slot
+void OwnershipIndex::bump(int owner, int slot, int delta) {
+    Border& b = bordersOf(owner)[slot];
+    b.count += delta;
+    if (b.count <= 0) {
+        b.count = 0;
+        if (b.pos >= 0) unlist(owner, b);
+    } else if (b.pos < 0 && store->getOwners()[slot] != owner) {
+        list(owner, slot, b);
+    }
+}
+
+void OwnershipIndex::moved(int slot, int from, int to) {
+    grow(std::max(from, to));
+
+    // owned lists: swap-remove from `from`, append to `to`
+    std::vector<Territory*>& lost = ownedBy[from];
+    const int pos = ownedPos[slot];
+    lost[pos] = lost.back();
+    ownedPos[lost[pos]->getIndex()] = pos;
+    lost.pop_back();
+    ownedPos[slot] = (int)ownedBy[to].size();
+    ownedBy[to].push_back(store->handle(slot));
+
+    // the territory itself: off the new owner's frontier, onto the old one's
+    // if it still borders something the old owner holds
+    Border& gained = bordersOf(to)[slot];
+    if (gained.pos >= 0) unlist(to, gained);
+    Border& left = bordersOf(from)[slot];
+    if (left.count > 0 && left.pos < 0) list(from, slot, left);
+
+    // its neighbors now border one territory less of `from`, one more of `to`
+    for (int nb : store->neighbors(slot)) {
+        bump(from, nb, -1);
+        bump(to, nb, +1);
+    }
+
+    // only the two owners' counts changed, so only they can gain or lose it
+    const int cont = store->getContinents()[slot];
+    heldBy(from, cont)--;
+    heldBy(to, cont)++;
+    settle(cont, from);
+    settle(cont, to);
+}
+
+void OwnershipIndex::regrouped(int slot, int from, int to) {
+    const int owner = store->getOwners()[slot];
+    growContinents(std::max(from, to));
+    continentSizes[from]--;
+    heldBy(owner, from)--;
+    continentSizes[to]++;
+    heldBy(owner, to)++;
+
+    // `to` grew: whoever held all of it no longer does, unless it's owner
+    if (controller[to] >= 0) settle(to, controller[to]);
+    settle(to, owner);
+    // `from` shrank: anyone can now hold all of it (rare, so just ask everyone)
+    if (controller[from] >= 0) settle(from, controller[from]);
+    for (int o = 0; o < (int)held.size() && controller[from] < 0; o++) settle(from, o);
+}
+
+const std::vector<Territory*>& OwnershipIndex::owned(int owner) const {
+    return owner >= 0 && owner < (int)ownedBy.size() ? ownedBy[owner] : noTerritories;
+}
+
+const std::vector<Territory*>& OwnershipIndex::frontier(int owner) const {
+    return owner >= 0 && owner < (int)frontierOf.size() ? frontierOf[owner] : noTerritories;
+}
+
+bool OwnershipIndex::onFrontier(int owner, int slot) const {
+    if (owner < 0 || owner >= (int)borders.size() || borders[owner].empty()) return false;
+    return borders[owner][slot].pos >= 0;
+}
+
+int OwnershipIndex::continentSize(int cont) const {
+    return cont >= 0 && cont < (int)continentSizes.size() ? continentSizes[cont] : 0;
+}
+
+int OwnershipIndex::heldIn(int owner, int cont) const {
+    if (owner < 0 || owner >= (int)held.size() || cont < 0 || cont >= (int)held[owner].size()) return 0;
+    return held[owner][cont];
+}
+
+int OwnershipIndex::controllerOf(int cont) const {
+    return cont >= 0 && cont < (int)controller.size() ? controller[cont] : -1;
+}
+
+const std::vector<int>& OwnershipIndex::controlled(int owner) const {
+    return owner >= 0 && owner < (int)controlledBy.size() ? controlledBy[owner] : noContinents;
+}
 
 // ============================================================================
 // Territory Implementation
 // ============================================================================
-// I keep all user-defined fields as pointers (per assignment rules).
-// I also implement the Rule of 3 (copy ctor, assignment, dtor).
+// A Territory is a handle: (store, slot). A stand-alone territory owns a
+// private 1-slot store; once a Map adopts it the data moves into the map's
+// store. I still implement the Rule of 3 (copy ctor, assignment, dtor), and a
+// copy is always a stand-alone territory with its own values.
+
+void Territory::bindPrivateStore(const std::string& n, const std::string& c,
+                                 const std::string& o, int a, int i) {
+    store = new TerritoryStore();
+    ownsStore = true;
+    slot = store->append(n, c, o, a, i, this);
+}
+
+// Bound constructor: the slot was already filled by TerritoryStore::create
+Territory::Territory(TerritoryStore* s, int i)
+    : store(s), slot(i), ownsStore(false), adjacentTerritories(new std::vector<Territory*>()) {}
 
 // Default constructor: safe defaults so a "blank" territory won't crash
 Territory::Territory() {
-    name = new std::string("Unknown");
-    continent = new std::string("Unknown");
-    owner = new std::string("Neutral");
-    armies = new int(0);
-    id = new int(-1);
+    bindPrivateStore("Unknown", "Unknown", "Neutral", 0, -1);
     adjacentTerritories = new std::vector<Territory*>();
 }
 
-// Copy constructor: deep copy all pointer fields
+// Copy constructor: copy values into a fresh private store
 Territory::Territory(const Territory& other) {
-    name = new std::string(*other.name);
-    continent = new std::string(*other.continent);
-    owner = new std::string(*other.owner);
-    armies = new int(*other.armies);
-    id = new int(*other.id);
+    bindPrivateStore(other.getName(), other.getContinent(), other.getOwner(),
+                     other.getArmies(), other.getId());
     // Shallow with respect to neighbor objects, but we copy the container
     adjacentTerritories = new std::vector<Territory*>(*other.adjacentTerritories);
 }
@@ -40,11 +563,7 @@ Territory::Territory(const Territory& other) {
 // Parameterized constructor: normal creation path
 Territory::Territory(std::string name, std::string continent, std::string owner,
                      int armies, int id, std::vector<Territory*>* adjacent) {
-    this->name = new std::string(name);
-    this->continent = new std::string(continent);
-    this->owner = new std::string(owner);
-    this->armies = new int(armies);
-    this->id = new int(id);
+    bindPrivateStore(name, continent, owner, armies, id);
     // We copy the vector so external callers keep ownership of their container
     // BUT: the caller might pass nullptr; handle that safely.
     if (adjacent) {
@@ -54,52 +573,56 @@ Territory::Territory(std::string name, std::string continent, std::string owner,
     }
 }
 
-// Assignment operator: clean old heap data, then deep-copy
+// Assignment operator: copy values into my slot (I stay bound where I am)
 Territory& Territory::operator=(const Territory& other) {
     if (this != &other) {
-        delete name;
-        delete continent;
-        delete owner;
-        delete armies;
-        delete id;
+        setName(other.getName());
+        setContinent(other.getContinent());
+        setOwner(other.getOwner());
+        setArmies(other.getArmies());
+        setId(other.getId());
         delete adjacentTerritories;
-
-        name = new std::string(*other.name);
-        continent = new std::string(*other.continent);
-        owner = new std::string(*other.owner);
-        armies = new int(*other.armies);
-        id = new int(*other.id);
         adjacentTerritories = new std::vector<Territory*>(*other.adjacentTerritories);
+        store->touchTopology();
     }
     return *this;
 }
 
-// Destructor: free everything I allocated
+// Destructor: give my slot back (or free my private store)
 Territory::~Territory() {
-    delete name;
-    delete continent;
-    delete owner;
-    delete armies;
-    delete id;
+    if (ownsStore) delete store;
+    else if (store) store->release(slot);
     delete adjacentTerritories; // note: we don't own neighbor territories
 }
 
 // --- Getters ---
-std::string Territory::getName() const { return *name; }
-std::string Territory::getContinent() const { return *continent; }
-std::string Territory::getOwner() const { return *owner; }
-int Territory::getArmies() const { return *armies; }
-int Territory::getId() const { return *id; }
+std::string Territory::getName() const { return store->getNames()[slot]; }
+std::string Territory::getContinent() const { return store->continentName(store->getContinents()[slot]); }
+std::string Territory::getOwner() const { return store->ownerName(store->getOwners()[slot]); }
+int Territory::getArmies() const { return store->getArmies()[slot]; }
+int Territory::getId() const { return store->getIds()[slot]; }
+int Territory::getOwnerIndex() const { return store->getOwners()[slot]; }
+int Territory::getOwnerId() const { return store->playerOf(store->getOwners()[slot]); }
 std::vector<Territory*>* Territory::getAdjacentTerritories() const { return adjacentTerritories; }
 
+// Compare against the interned name, no std::string copy per call
+bool Territory::isOwnedBy(const std::string& ownerName) const {
+    return store->ownerName(store->getOwners()[slot]) == ownerName;
+}
+
 // --- Setters ---
-void Territory::setName(std::string name) { *this->name = name; }
-void Territory::setContinent(std::string continent) { *this->continent = continent; }
-void Territory::setOwner(std::string owner) { *this->owner = owner; }
-void Territory::setArmies(int armies) { *this->armies = armies; }
-void Territory::setId(int id) { *this->id = id; }
+void Territory::setName(std::string name) { store->setName(slot, name); }
+void Territory::setContinent(std::string continent) { store->setContinent(slot, store->internContinent(continent)); }
+void Territory::setOwner(std::string owner) { store->setOwner(slot, store->internOwner(owner)); }
+void Territory::setOwnerId(int playerId) {
+    const int owner = store->ownerOf(playerId);
+    if (owner >= 0) store->setOwner(slot, owner);
+}
+void Territory::setArmies(int armies) { store->setArmies(slot, armies); }
+void Territory::setId(int id) { store->setId(slot, id); }
 // --- Setters ---
 void Territory::setAdjacentTerritories(std::vector<Territory*>* adj) {
+    store->touchTopology();
     delete adjacentTerritories;
     // Guard nullptr: replace with empty vector if none provided
     if (adj) {
@@ -115,6 +638,7 @@ void Territory::addAdjacentTerritory(Territory* territory) {
         if (*t == *territory) return;
     }
     adjacentTerritories->push_back(territory);
+    store->touchTopology();
 }
 
 // Remove a neighbor by matching ID
@@ -122,15 +646,16 @@ void Territory::removeAdjacentTerritory(Territory* territory) {
     auto it = std::remove_if(adjacentTerritories->begin(), adjacentTerritories->end(),
                              [territory](Territory* t) { return *t == *territory; });
     if (it != adjacentTerritories->end()) adjacentTerritories->erase(it, adjacentTerritories->end());
+    store->touchTopology();
 }
 
 // Nice console output helper for debugging
 void Territory::printTerritoryInfo() const {
-    std::cout << "Territory ID: " << *id << "\n";
-    std::cout << "Name: " << *name << "\n";
-    std::cout << "Continent: " << *continent << "\n";
-    std::cout << "Owner: " << *owner << "\n";
-    std::cout << "Armies: " << *armies << "\n";
+    std::cout << "Territory ID: " << getId() << "\n";
+    std::cout << "Name: " << getName() << "\n";
+    std::cout << "Continent: " << getContinent() << "\n";
+    std::cout << "Owner: " << getOwner() << "\n";
+    std::cout << "Armies: " << getArmies() << "\n";
     std::cout << "Adjacent: ";
     for (auto t : *adjacentTerritories) std::cout << t->getName() << " ";
     std::cout << "\n";
@@ -138,32 +663,51 @@ void Territory::printTerritoryInfo() const {
 
 // Stream insertion (minimal one-line summary)
 std::ostream& operator<<(std::ostream& out, const Territory& t) {
-    out << "Territory ID: " << *t.id
-        << " Name: " << *t.name
-        << " Continent: " << *t.continent
-        << " Owner: " << *t.owner
-        << " Armies: " << *t.armies;
+    out << "Territory ID: " << t.getId()
+        << " Name: " << t.getName()
+        << " Continent: " << t.getContinent()
+        << " Owner: " << t.getOwner()
+        << " Armies: " << t.getArmies();
     return out;
 }
 
 // Equality by ID (IDs are the primary identity)
 bool Territory::operator==(const Territory& other) const {
-    return *id == *other.id;
+    return getId() == other.getId();
 }
 
 // Increment/decrement army count
-Territory& Territory::operator++() { ++(*armies); return *this; }
-Territory Territory::operator++(int) { Territory tmp = *this; ++(*armies); return tmp; }
-Territory& Territory::operator--() { if (*armies > 0) --(*armies); return *this; }
-Territory Territory::operator--(int) { Territory tmp = *this; if (*armies > 0) --(*armies); return tmp; }
+Territory& Territory::operator++() { setArmies(getArmies() + 1); return *this; }
+Territory Territory::operator++(int) { Territory tmp = *this; setArmies(getArmies() + 1); return tmp; }
+Territory& Territory::operator--() { if (getArmies() > 0) setArmies(getArmies() - 1); return *this; }
+Territory Territory::operator--(int) { Territory tmp = *this; if (getArmies() > 0) setArmies(getArmies() - 1); return tmp; }
 
 // Adjacency checks (by object or by name)
+// When my store has a fresh adjacency index these are O(1) lookups; otherwise
+// I fall back to the adjacency vector (e.g. stand-alone territories).
 bool Territory::isAdjacent(const Territory& other) const {
+    if (store->hasAdjacency() && other.store == store) {
+        return store->adjacent(slot, other.slot);
+    }
     for (auto t : *adjacentTerritories) if (*t == other) return true;
     return false;
 }
 bool Territory::isAdjacent(const std::string& name) const {
-    for (auto t : *adjacentTerritories) if (t->getName() == name) return true;
+    if (store->hasAdjacency()) {
+        const int target = store->slotOfName(name);
+        if (target >= 0 && store->adjacent(slot, target)) return true;
+        if (target == -2) {
+            // duplicated name: check each neighbor, still without copying strings
+            const std::vector<std::string>& names = store->getNames();
+            for (int nb : store->neighbors(slot)) if (names[nb] == name) return true;
+        }
+        // The index only has neighbors in this store. If they're all there,
+        // its "no" is final; otherwise scan, like the Territory& overload.
+        if (store->neighbors(slot).size() == (int)adjacentTerritories->size()) return false;
+    }
+    for (auto t : *adjacentTerritories) {
+        if (t->store->getNames()[t->slot] == name) return true;
+    }
     return false;
 }
 
@@ -177,6 +721,9 @@ Continent::Continent() {
     name = new std::string("Unknown");
     id = new int(-1);
     territories = new std::vector<Territory*>();
+    memberIds = new std::unordered_set<int>();
+    memberIdsStale = false;
+    memberIdsAt = TerritoryStore::getIdVersion();
 }
 
 // Copy ctor: deep copy pointer fields (container is copied, elements are non-owned)
@@ -184,6 +731,9 @@ Continent::Continent(const Continent& other) {
     name = new std::string(*other.name);
     id = new int(*other.id);
     territories = new std::vector<Territory*>(*other.territories);
+    memberIds = new std::unordered_set<int>(*other.memberIds);
+    memberIdsStale = other.memberIdsStale;
+    memberIdsAt = other.memberIdsAt;
 }
 
 // Param ctor
@@ -191,6 +741,10 @@ Continent::Continent(std::string name, int id, std::vector<Territory*>* terrs) {
     this->name = new std::string(name);
     this->id = new int(id);
     territories = new std::vector<Territory*>(*terrs);
+    memberIds = new std::unordered_set<int>();
+    memberIdsStale = true;
+    memberIdsAt = 0;
+    syncMemberIds();
 }
 
 // Dtor
@@ -198,40 +752,66 @@ Continent::~Continent() {
     delete name;
     delete id;
     delete territories; // we do not own the Territory* elements
+    delete memberIds;
 }
 
 // Assignment operator
 Continent& Continent::operator=(const Continent& other) {
     if (this != &other) {
-        delete name; delete id; delete territories;
+        delete name; delete id; delete territories; delete memberIds;
         name = new std::string(*other.name);
         id = new int(*other.id);
         territories = new std::vector<Territory*>(*other.territories);
+        memberIds = new std::unordered_set<int>(*other.memberIds);
+        memberIdsStale = other.memberIdsStale;
+        memberIdsAt = other.memberIdsAt;
     }
     return *this;
 }
 
+// Rebuild the member-ID set if the vector may have been changed behind our back
+// or a member was given a new ID
+void Continent::syncMemberIds() {
+    const unsigned idsNow = TerritoryStore::getIdVersion();
+    if (!memberIdsStale && memberIdsAt == idsNow) return;
+    memberIds->clear();
+    memberIds->reserve(territories->size());
+    for (auto t : *territories) memberIds->insert(t->getId());
+    memberIdsStale = false;
+    memberIdsAt = idsNow;
+}
+
 // --- Getters/Setters ---
 std::string Continent::getName() const { return *name; }
 int Continent::getId() const { return *id; }
-std::vector<Territory*>* Continent::getTerritories() const { return territories; }
+std::vector<Territory*>* Continent::getTerritories() {
+    memberIdsStale = true;   // the caller may edit it
+    return territories;
+}
+const std::vector<Territory*>* Continent::getTerritories() const { return territories; }
 
 void Continent::setName(std::string n) { *name = n; }
 void Continent::setId(int i) { *id = i; }
 void Continent::setTerritories(std::vector<Territory*>* terrs) {
     delete territories;
     territories = new std::vector<Territory*>(*terrs);
+    memberIdsStale = true;
+    syncMemberIds();
 }
 
 // Add/remove territory pointers (no ownership)
 void Continent::addTerritory(Territory* t) {
-    for (auto terr : *territories) if (*terr == *t) return; // avoid duplicates
+    syncMemberIds();
+    if (!memberIds->insert(t->getId()).second) return; // avoid duplicates
     territories->push_back(t);
 }
 void Continent::removeTerritory(Territory* t) {
     auto it = std::remove_if(territories->begin(), territories->end(),
                              [t](Territory* terr) { return *terr == *t; });
-    if (it != territories->end()) territories->erase(it, territories->end());
+    if (it != territories->end()) {
+        territories->erase(it, territories->end());
+        memberIds->erase(t->getId());
+    }
 }
 
 // Pretty-print a quick list
@@ -258,60 +838,285 @@ std::ostream& operator<<(std::ostream& out, const Continent& c) {
 Map::Map() {
     territories = new std::vector<Territory*>();
     continents = new std::vector<Continent*>();
+    store = new TerritoryStore();
+    territoryIndex = new std::unordered_map<int, Territory*>();
+    continentIndex = new std::unordered_map<int, Continent*>();
 }
 
-// Copy ctor: deep copy owned objects
-Map::Map(const Map& other) {
+// Rebuild the ID indexes if a vector may have been edited directly
+// (getTerritories() and getContinents() hand out the raw vectors) or a
+// territory was given a new ID. With duplicate IDs in a vector the first one
+// wins, like the old scans.
+void Map::syncIndexes() {
+    const unsigned idsNow = TerritoryStore::getIdVersion();
+    if (!indexesStale && indexedIdsAt == idsNow) return;
+    territoryIndex->clear();
+    territoryIndex->reserve(territories->size());
+    for (auto t : *territories) territoryIndex->insert(std::make_pair(t->getId(), t));
+    continentIndex->clear();
+    for (auto c : *continents) continentIndex->insert(std::make_pair(c->getId(), c));
+    indexesStale = false;
+    indexedIdsAt = idsNow;
+}
+
+// Bind a territory's fields into this map's store (no-op if already there)
+void Map::attach(Territory* t) {
+    store->adopt(t);
+}
+
+// Free everything we own. Handles are unbound first so each delete doesn't
+// have to swap-remove its slot one by one.
+void Map::releaseAll() {
+    store->unbindAll();
+    for (auto t : *territories) delete t;
+    delete territories;
+    for (auto c : *continents) delete c;
+    delete continents;
+}
+
+// Copy = other's topology (shared with it if it has one) + its state. The
+// copy's territories, borders and continents only ever point at its own
+// territories.
+void Map::copyFrom(const Map& other) {
+    std::shared_ptr<const MapTopology> topo = other.topology();
+    buildFrom(*topo, other.saveState());
+    sharedTopology = topo;
+    topologyAt = store->getTopologyVersion();
+}
+
+// Fill an empty map (no territory/continent vectors yet) from a topology and
+// a state, straight into the store like loadBinary does. A state for another
+// topology leaves the territories it doesn't cover neutral and empty.
+void Map::buildFrom(const MapTopology& topo, const MapState& state) {
+    const int n = topo.size();
+    store->reserve(n);
+    std::vector<int> contIdx(topo.continentNames.size());
+    for (int c = 0; c < (int)contIdx.size(); c++) contIdx[c] = store->internContinent(topo.continentNames[c]);
+    std::vector<int> ownerIdx(state.ownerNames.size());
+    for (int k = 0; k < (int)ownerIdx.size(); k++) ownerIdx[k] = store->internOwner(state.ownerNames[k]);
+    const int neutral = store->internOwner("Neutral");
+
     territories = new std::vector<Territory*>();
-    for (auto t : *other.territories) territories->push_back(new Territory(*t));
+    territories->reserve(n);
+    for (int t = 0; t < n; t++) {
+        int owner = neutral, armies = 0;
+        if (t < (int)state.owners.size() && t < (int)state.armies.size()) {
+            const int k = state.owners[t];
+            if (k >= 0 && k < (int)ownerIdx.size()) owner = ownerIdx[k];
+            armies = state.armies[t];
+        }
+        territories->push_back(store->create(topo.names[t], contIdx[topo.continentOfTerritory[t]],
+                                             owner, armies, topo.ids[t]));
+    }
+    for (int t = 0; t < n; t++) {
+        std::vector<Territory*>* adj = (*territories)[t]->getAdjacentTerritories();
+        NeighborRange nbs = topo.neighbors(t);
+        adj->reserve(nbs.size());
+        for (int nb : nbs) adj->push_back((*territories)[nb]);
+    }
+
     continents = new std::vector<Continent*>();
-    for (auto c : *other.continents) continents->push_back(new Continent(*c));
+    continents->reserve(topo.continentList.size());
+    std::vector<Territory*> members;
+    for (const auto& info : topo.continentList) {
+        members.clear();
+        for (int m : info.members) members.push_back((*territories)[m]);
+        continents->push_back(new Continent(info.name, info.id, &members));
+    }
+    store->buildAdjacency();
+}
+
+// Copy ctor: own territories and continents, shared topology
+Map::Map(const Map& other) {
+    store = new TerritoryStore();
+    territoryIndex = new std::unordered_map<int, Territory*>();
+    continentIndex = new std::unordered_map<int, Continent*>();
+    copyFrom(other);
 }
 
-// Assignment operator: free current, deep copy from other
+// Assignment operator: free current, copy from other
 Map& Map::operator=(const Map& other) {
     if (this != &other) {
-        for (auto t : *territories) delete t;
-        delete territories;
-        for (auto c : *continents) delete c;
-        delete continents;
-
-        territories = new std::vector<Territory*>();
-        for (auto t : *other.territories) territories->push_back(new Territory(*t));
-        continents = new std::vector<Continent*>();
-        for (auto c : *other.continents) continents->push_back(new Continent(*c));
+        releaseAll();
+        territoryIndex->clear();
+        continentIndex->clear();
+        indexesStale = true;
+        sharedTopology.reset();
+        copyFrom(other);
     }
     return *this;
 }
 
 // Param ctor: deep copy passed-in containers
 Map::Map(std::vector<Territory*>* t, std::vector<Continent*>* c) {
+    store = new TerritoryStore();
+    territoryIndex = new std::unordered_map<int, Territory*>();
+    continentIndex = new std::unordered_map<int, Continent*>();
     territories = new std::vector<Territory*>();
-    for (auto terr : *t) territories->push_back(new Territory(*terr));
+    for (auto terr : *t) {
+        Territory* copy = new Territory(*terr);
+        attach(copy);
+        territories->push_back(copy);
+    }
     continents = new std::vector<Continent*>();
     for (auto cont : *c) continents->push_back(new Continent(*cont));
 }
 
+// A fresh game board on a shared topology
+Map::Map(std::shared_ptr<const MapTopology> topology, const MapState& state) {
+    store = new TerritoryStore();
+    territoryIndex = new std::unordered_map<int, Territory*>();
+    continentIndex = new std::unordered_map<int, Continent*>();
+    buildFrom(*topology, state);
+    sharedTopology = std::move(topology);
+    topologyAt = store->getTopologyVersion();
+}
+
 // Dtor: we own and delete everything
 Map::~Map() {
-    for (auto t : *territories) delete t;
-    delete territories;
-    for (auto c : *continents) delete c;
-    delete continents;
+    releaseAll();
+    delete store;
+    delete territoryIndex;
+    delete continentIndex;
 }
 
-// --- Getters ---
-std::vector<Territory*>* Map::getTerritories() const { return territories; }
-std::vector<Continent*>* Map::getContinents() const { return continents; }
+// --- Getters --- (non-const: the caller may edit the vectors, so the ID
+// indexes go stale)
+std::vector<Territory*>* Map::getTerritories() {
+    indexesStale = true;
+    return territories;
+}
+std::vector<Continent*>* Map::getContinents() {
+    indexesStale = true;
+    return continents;
+}
+const std::vector<Territory*>* Map::getTerritories() const { return territories; }
+const std::vector<Continent*>* Map::getContinents() const { return continents; }
+TerritoryStore* Map::getStore() const { return store; }
+
+// --- CSR adjacency ---
+void Map::buildAdjacencyIndex() {
+    sharedTopology.reset();   // borders may have been edited by hand
+    store->buildAdjacency();
+}
+bool Map::hasAdjacencyIndex() const { return store->hasAdjacency(); }
+const OwnershipIndex& Map::getOwnership() { return store->ownershipIndex(); }
+int Map::ownerIndex(const std::string& owner) const { return store->findOwner(owner); }
+int Map::continentIndexOf(const std::string& continent) const { return store->findContinent(continent); }
+NeighborRange Map::neighbors(int idx) const { return store->neighbors(idx); }
+
+// --- Topology / state split ---
+// The shared topology is only handed back while the store's topology version
+// says nothing was added, removed or rewired since it was taken; otherwise
+// (or for a map that never had one) this is a fresh snapshot.
+std::shared_ptr<const MapTopology> Map::topology() const {
+    if (sharedTopology && topologyAt == store->getTopologyVersion()) return sharedTopology;
+
+    auto topo = std::make_shared<MapTopology>();
+    const int n = (int)territories->size();
+    std::vector<int> position(store->size(), -1);   // store slot -> territory number
+    for (int i = 0; i < n; i++) {
+        Territory* t = (*territories)[i];
+        if (t->getStore() == store) position[t->getIndex()] = i;
+    }
+    auto numberOf = [&](Territory* t) {
+        return t != nullptr && t->getStore() == store ? position[t->getIndex()] : -1;
+    };
+
+    topo->names.reserve(n);
+    topo->ids.reserve(n);
+    topo->continentOfTerritory.reserve(n);
+    topo->borderOffsets.reserve(n + 1);
+    topo->borderOffsets.push_back(0);
+    for (int c = 0; c < store->continentCount(); c++) topo->continentNames.push_back(store->continentName(c));
+    const std::vector<int>& conts = store->getContinents();
+    for (int i = 0; i < n; i++) {
+        Territory* t = (*territories)[i];
+        topo->names.push_back(t->getName());
+        topo->ids.push_back(t->getId());
+        topo->continentOfTerritory.push_back(conts[t->getIndex()]);   // every listed territory is in our store
+        for (auto nb : *t->getAdjacentTerritories()) {
+            const int k = numberOf(nb);
+            if (k >= 0) topo->borderTargets.push_back(k);
+        }
+        topo->borderOffsets.push_back((int)topo->borderTargets.size());
+    }
+
+    topo->continentList.reserve(continents->size());
+    for (const Continent* c : *continents) {
+        MapTopology::ContinentInfo info;
+        info.name = c->getName();
+        info.id = c->getId();
+        for (auto t : *c->getTerritories()) {
+            const int k = numberOf(t);
+            if (k >= 0) info.members.push_back(k);
+        }
+        topo->continentList.push_back(std::move(info));
+    }
+    return topo;
+}
+
+MapState Map::saveState() const {
+    MapState state;
+    const int n = (int)territories->size();
+    state.ownerNames.reserve(store->ownerCount());
+    for (int k = 0; k < store->ownerCount(); k++) state.ownerNames.push_back(store->ownerName(k));
+    state.owners.resize(n);
+    state.armies.resize(n);
+    const std::vector<int>& owners = store->getOwners();
+    const std::vector<int>& armies = store->getArmies();
+    for (int i = 0; i < n; i++) {
+        const int slot = (*territories)[i]->getIndex();
+        state.owners[i] = owners[slot];
+        state.armies[i] = armies[slot];
+    }
+    return state;
+}
+
+// Reset this board to a saved state: armies in place, owners as one new
+// column so the ownership index is rebuilt once rather than per territory.
+bool Map::loadState(const MapState& state) {
+    const int n = (int)territories->size();
+    if ((int)state.owners.size() != n || (int)state.armies.size() != n) return false;
+    for (int k : state.owners) {
+        if (k < 0 || k >= (int)state.ownerNames.size()) return false;
+    }
+    std::vector<int> remap(state.ownerNames.size());
+    for (int k = 0; k < (int)remap.size(); k++) remap[k] = store->internOwner(state.ownerNames[k]);
+    // not journaled, and there's nothing left to undo to afterwards
+    StateJournal* journal = store->getJournal();
+    store->setJournal(nullptr);
+    std::vector<int> owners(store->getOwners());
+    for (int i = 0; i < n; i++) {
+        const int slot = (*territories)[i]->getIndex();
+        owners[slot] = remap[state.owners[i]];
+        store->setArmies(slot, state.armies[i]);
+    }
+    store->replaceOwners(std::move(owners));
+    if (journal != nullptr) journal->clear();
+    store->setJournal(journal);
+    return true;
+}
 
 // --- Setters (replace entire collections with deep copies) ---
 void Map::setTerritories(std::vector<Territory*>* t) {
+    sharedTopology.reset();
+    store->unbindAll();
+    territoryIndex->clear();
+    indexesStale = true;
     for (auto terr : *territories) delete terr;
     delete territories;
     territories = new std::vector<Territory*>();
-    for (auto terr : *t) territories->push_back(new Territory(*terr));
+    for (auto terr : *t) {
+        Territory* copy = new Territory(*terr);
+        attach(copy);
+        territories->push_back(copy);
+    }
 }
 void Map::setContinents(std::vector<Continent*>* c) {
+    sharedTopology.reset();
+    continentIndex->clear();
+    indexesStale = true;
     for (auto cont : *continents) delete cont;
     delete continents;
     continents = new std::vector<Continent*>();
@@ -322,37 +1127,56 @@ void Map::setContinents(std::vector<Continent*>* c) {
 // NOTE: We store the *same pointer* the loader creates so cross-links (continent->territory)
 // and validations by pointer/ID stay consistent.
 void Map::addTerritory(Territory* t) {
-    for (auto terr : *territories) {
-        if (*terr == *t) return; // avoid duplicates by ID
-    }
+    syncIndexes();
+    if (!territoryIndex->insert(std::make_pair(t->getId(), t)).second) return; // avoid duplicates by ID
+    attach(t);
     territories->push_back(t);
 }
 
 void Map::removeTerritory(Territory* t) {
-    auto it = std::remove_if(territories->begin(), territories->end(),
-                             [t](Territory* terr) { return *terr == *t; });
+    const int id = t->getId();
+    auto it = std::find_if(territories->begin(), territories->end(),
+                           [id](Territory* terr) { return terr->getId() == id; });
     if (it != territories->end()) {
-        delete *it; // we own the territory
-        territories->erase(it, territories->end());
+        Territory* owned = *it;
+        territories->erase(it);
+        territoryIndex->erase(id);
+        delete owned; // we own the territory
     }
 }
 
 // Add/remove continent pointers (same-pointer rule as above)
 void Map::addContinent(Continent* c) {
-    for (auto cont : *continents) {
-        if (cont->getId() == c->getId()) return; // avoid duplicate same ID
-    }
+    syncIndexes();
+    if (!continentIndex->insert(std::make_pair(c->getId(), c)).second) return; // avoid duplicate same ID
+    sharedTopology.reset();
     continents->push_back(c);
 }
 void Map::removeContinent(Continent* c) {
-    auto it = std::remove_if(continents->begin(), continents->end(),
-                             [c](Continent* cont) { return cont->getId() == c->getId(); });
+    const int id = c->getId();
+    auto it = std::find_if(continents->begin(), continents->end(),
+                           [id](Continent* cont) { return cont->getId() == id; });
     if (it != continents->end()) {
-        delete *it; // we own the continent
-        continents->erase(it, continents->end());
+        Continent* owned = *it;
+        sharedTopology.reset();
+        continents->erase(it);
+        continentIndex->erase(id);
+        delete owned; // we own the continent
     }
 }
 
+// O(1) lookups by ID
+Territory* Map::findTerritory(int id) {
+    syncIndexes();
+    auto it = territoryIndex->find(id);
+    return it == territoryIndex->end() ? nullptr : it->second;
+}
+Continent* Map::findContinent(int id) {
+    syncIndexes();
+    auto it = continentIndex->find(id);
+    return it == continentIndex->end() ? nullptr : it->second;
+}
+
 // ============================================================================
 // Validation (Assignment Part 1)
 //  1) Entire map is a connected graph.
@@ -360,21 +1184,76 @@ void Map::removeContinent(Continent* c) {
 //  3) Every territory belongs to exactly one continent.
 // ============================================================================
 bool Map::validate() const {
+    // Serial run of the validation engine below (same rules, same messages)
+    ValidationOptions serial;
+    serial.threads = 1;
+    return validate(serial);
+}
+
+// ============================================================================
+// Validation engine
+// ============================================================================
+// Checks the same rules in the same order as validate() and prints the same
+// first failure, but:
+//  - rule 3 is one pass over the continent member lists (per-slot counters)
+//    instead of territories x continents x members
+//  - connectivity uses GraphTraversal (iterative BFS over the CSR index), so
+//    long chain-like maps can't overflow the stack
+//  - once rule 3 holds, every slot has exactly one continent, so the
+//    per-continent checks are independent and can run concurrently
+
+namespace {
+
+int validationThreads(const ValidationOptions& options) {
+    if (options.pool) return options.pool->size();
+    return options.threads > 0 ? options.threads : ThreadPool::defaultThreadCount();
+}
+
+// Runs every task in singles once, plus spread(w, workers) for each worker w,
+// on options.pool (or a temporary pool of `workers` threads), and waits.
+void runValidationTasks(const ValidationOptions& options, int workers,
+                        const std::vector<std::function<void()>>& singles,
+                        const std::function<void(int, int)>& spread) {
+    std::unique_ptr<ThreadPool> ownPool;
+    ThreadPool* pool = options.pool;
+    if (!pool) {
+        ownPool.reset(new ThreadPool(workers));
+        pool = ownPool.get();
+    }
+    std::vector<std::future<void>> done;
+    for (auto& task : singles) done.push_back(pool->submit(task));
+    for (int w = 0; w < workers; w++) {
+        done.push_back(pool->submit([&spread, w, workers]() { spread(w, workers); }));
+    }
+    for (auto& f : done) f.get();
+}
+
+} // namespace
+
+bool Map::validate(const ValidationOptions& options) const {
     if (territories->empty() || continents->empty()) {
-        std::cout << " Validation failed: map has no territories or continents.\n";
+        if (options.log) std::cout << " Validation failed: map has no territories or continents.\n";
         return false;
     }
 
-    // --- Rule 3: Each territory must belong to exactly one continent
-    for (auto terr : *territories) {
-        int count = 0;
-        for (auto cont : *continents) {
-            for (auto t : *cont->getTerritories()) {
-                if (*t == *terr) count++;
-            }
+    store->ensureAdjacency();
+    const int n = store->size();
+
+    // --- Rule 3: one pass over all continent members
+    std::vector<int> memberCount(n, 0);
+    std::vector<int> continentOf(n, -1);
+    for (int c = 0; c < (int)continents->size(); c++) {
+        const Continent* cont = (*continents)[c];
+        for (auto t : *cont->getTerritories()) {
+            if (t->getStore() != store) continue;
+            memberCount[t->getIndex()]++;
+            continentOf[t->getIndex()] = c;
         }
+    }
+    for (auto terr : *territories) {
+        int count = memberCount[terr->getIndex()];
         if (count != 1) {
-            std::cout << " Validation failed: territory " << terr->getName()
+            if (options.log) std::cout << " Validation failed: territory " << terr->getName()
                       << " (ID=" << terr->getId()
                       << ") belongs to " << count << " continents.\n";
             return false;
@@ -382,76 +1261,242 @@ bool Map::validate() const {
     }
 
     // Guard: no empty continents (helps catch typos in map files)
-    for (auto cont : *continents) {
+    for (const Continent* cont : *continents) {
         if (cont->getTerritories()->empty()) {
-            std::cout << " Validation failed: continent " << cont->getName()
+            if (options.log) std::cout << " Validation failed: continent " << cont->getName()
                       << " has no territories.\n";
             return false;
         }
     }
 
-    // --- Rule 1: Whole-map connectivity via DFS (by ID indexing)
-    std::map<int, int> idToIndex;
-    for (int i = 0; i < (int)territories->size(); i++) {
-        idToIndex[(*territories)[i]->getId()] = i;
-    }
-
-    std::vector<bool> visited(territories->size(), false);
-    std::function<void(Territory*)> dfs = [&](Territory* t) {
-        int idx = idToIndex[t->getId()];
-        if (visited[idx]) return;
-        visited[idx] = true;
-        for (auto neighbor : *(t->getAdjacentTerritories())) {
-            dfs(neighbor);
+    // --- Rules 1 and 2 as independent tasks
+    // firstMissing[0] is for the whole map, firstMissing[c+1] for continent c:
+    // the first territory (in the order we report them) that was not reached.
+    const int nConts = (int)continents->size();
+    std::vector<Territory*> firstMissing(nConts + 1, nullptr);
+
+    auto wholeMap = [&]() {
+        GraphTraversal walk(*store);
+        walk.run(territories->front()->getIndex());
+        for (auto terr : *territories) {
+            if (!walk.visited(terr->getIndex())) { firstMissing[0] = terr; break; }
+        }
+    };
+    // Continents first, first+stride, ... sharing one traversal (reset per continent)
+    auto continentsFrom = [&](int first, int stride) {
+        GraphTraversal walk(*store);
+        for (int c = first; c < nConts; c += stride) {
+            const Continent* cont = (*continents)[c];
+            const std::vector<Territory*>* terrs = cont->getTerritories();
+            walk.reset();
+            walk.run(terrs->front()->getIndex(), GraphTraversal::BreadthFirst,
+                     [&continentOf, c](int slot) { return continentOf[slot] == c; });
+            for (auto t : *terrs) {
+                if (!walk.visited(t->getIndex())) { firstMissing[c + 1] = t; break; }
+            }
         }
     };
 
-    dfs(territories->front());
-    for (int i = 0; i < (int)visited.size(); i++) {
-        if (!visited[i]) {
-            std::cout << " Validation failed: territory "
-                      << (*territories)[i]->getName()
-                      << " (ID=" << (*territories)[i]->getId()
-                      << ") is not connected to the map.\n";
+    const int threads = validationThreads(options);
+    if (threads <= 1 || nConts < 2) {
+        wholeMap();
+        if (!firstMissing[0]) continentsFrom(0, 1);
+    } else {
+        runValidationTasks(options, std::min(threads, nConts), { wholeMap }, continentsFrom);
+    }
+
+    if (firstMissing[0]) {
+        if (options.log) std::cout << " Validation failed: territory "
+                  << firstMissing[0]->getName()
+                  << " (ID=" << firstMissing[0]->getId()
+                  << ") is not connected to the map.\n";
+        return false;
+    }
+    for (int c = 0; c < nConts; c++) {
+        if (firstMissing[c + 1]) {
+            if (options.log) std::cout << " Validation failed: continent " << (*continents)[c]->getName()
+                      << " is not fully connected. Territory "
+                      << firstMissing[c + 1]->getName()
+                      << " (ID=" << firstMissing[c + 1]->getId()
+                      << ") is isolated.\n";
             return false;
         }
     }
 
-    // --- Rule 2: Per-continent connectivity (subgraph induced by continent)
-    for (auto cont : *continents) {
-        auto terrs = cont->getTerritories();
-        if (terrs->empty()) continue; // already guarded, but cheap
+    if (options.log) std::cout << " Map validation passed.\n";
+    return true;
+}
+
+// ============================================================================
+// Validation report
+// ============================================================================
+// validateAll() checks the same rules as validate() but keeps going, so a map
+// pipeline can fix everything after one run instead of one problem per run.
+// Components come from reachability: start at the first unreached territory
+// (in map order), everything it reaches is one component, repeat.
+// Work is split like validate(): whole map + border symmetry are two tasks,
+// continents are strided across the rest of the workers.
+
+namespace {
+
+// Largest component first; ties keep discovery order
+void sortComponents(std::vector<std::vector<int>>& comps) {
+    std::stable_sort(comps.begin(), comps.end(),
+                     [](const std::vector<int>& a, const std::vector<int>& b) { return a.size() > b.size(); });
+}
+
+// IDs of the slots the last GraphTraversal::run() marked
+std::vector<int> lastComponent(const GraphTraversal& walk, int count, const TerritoryStore& store) {
+    const std::vector<int>& marked = walk.marked();
+    std::vector<int> ids;
+    ids.reserve(count);
+    for (std::size_t i = marked.size() - count; i < marked.size(); i++) {
+        ids.push_back(store.getIds()[marked[i]]);
+    }
+    return ids;
+}
+
+} // namespace
+
+void ValidationReport::print(std::ostream& out) const {
+    for (auto& issue : issues) out << issue.message << "\n";
+    if (passed()) {
+        out << " Map validation passed";
+        if (warningCount > 0) out << " (" << warningCount << " warnings)";
+        out << ".\n";
+    } else {
+        out << " Map validation failed: " << errorCount << " errors, "
+            << warningCount << " warnings.\n";
+    }
+}
+
+ValidationReport Map::validateAll(const ValidationOptions& options) const {
+    ValidationReport report;
+    auto add = [&report](ValidationIssue::Kind kind, int terrId, int otherId, int contId,
+                         int count, const std::string& message) {
+        ValidationIssue issue;
+        issue.kind = kind;
+        issue.territoryId = terrId;
+        issue.otherId = otherId;
+        issue.continentId = contId;
+        issue.count = count;
+        issue.message = message;
+        if (issue.isError()) report.errorCount++; else report.warningCount++;
+        report.issues.push_back(issue);
+    };
+
+    if (territories->empty() || continents->empty()) {
+        add(ValidationIssue::EmptyMap, -1, -1, -1, 0,
+            " Validation failed: map has no territories or continents.");
+        if (options.log) report.print(std::cout);
+        return report;
+    }
+
+    store->ensureAdjacency();
+    const int n = store->size();
+    const int nConts = (int)continents->size();
 
-        std::map<int, int> localMap;
-        for (int i = 0; i < (int)terrs->size(); i++) {
-            localMap[terrs->at(i)->getId()] = i;
+    // --- Membership: one pass over all continent member lists
+    std::vector<int> memberCount(n, 0);
+    for (const Continent* cont : *continents) {
+        for (auto t : *cont->getTerritories()) {
+            if (t->getStore() == store) memberCount[t->getIndex()]++;
         }
+    }
+    for (auto terr : *territories) {
+        int count = memberCount[terr->getIndex()];
+        if (count == 1) continue;
+        add(count == 0 ? ValidationIssue::NoContinent : ValidationIssue::MultipleContinents,
+            terr->getId(), -1, -1, count,
+            " Validation failed: territory " + terr->getName() + " (ID=" + std::to_string(terr->getId())
+            + ") belongs to " + std::to_string(count) + " continents.");
+    }
+    for (const Continent* cont : *continents) {
+        if (cont->getTerritories()->empty()) {
+            add(ValidationIssue::EmptyContinent, -1, -1, cont->getId(), 0,
+                " Validation failed: continent " + cont->getName() + " has no territories.");
+        }
+    }
+
+    // --- Connectivity and border symmetry
+    std::vector<std::vector<int>> mapComps;
+    std::vector<std::vector<std::vector<int>>> contComps(nConts);
+    std::vector<std::pair<int, int>> oneWay;   // (from ID, to ID)
 
-        std::vector<bool> visitedCont(terrs->size(), false);
-        std::function<void(Territory*)> dfsCont = [&](Territory* t) {
-            int idx = localMap[t->getId()];
-            if (visitedCont[idx]) return;
-            visitedCont[idx] = true;
-            for (auto neighbor : *(t->getAdjacentTerritories())) {
-                if (localMap.count(neighbor->getId())) dfsCont(neighbor);
+    auto wholeMap = [&]() {
+        GraphTraversal walk(*store);
+        for (auto terr : *territories) {
+            int count = walk.run(terr->getIndex());
+            if (count > 0) mapComps.push_back(lastComponent(walk, count, *store));
+        }
+    };
+    auto borders = [&]() {
+        const std::vector<int>& ids = store->getIds();
+        for (auto terr : *territories) {
+            const int a = terr->getIndex();
+            for (int b : store->neighbors(a)) {
+                if (!store->adjacent(b, a)) oneWay.push_back(std::make_pair(ids[a], ids[b]));
             }
-        };
-
-        dfsCont(terrs->front());
-        for (int i = 0; i < (int)visitedCont.size(); i++) {
-            if (!visitedCont[i]) {
-                std::cout << " Validation failed: continent " << cont->getName()
-                          << " is not fully connected. Territory "
-                          << terrs->at(i)->getName()
-                          << " (ID=" << terrs->at(i)->getId()
-                          << ") is isolated.\n";
-                return false;
+        }
+    };
+    // A territory listed in several continents belongs to each of them here,
+    // so membership is a per-worker stamp array rather than continentOf[]
+    auto continentsFrom = [&](int first, int stride) {
+        GraphTraversal walk(*store);
+        std::vector<int> stamp(n, -1);
+        for (int c = first; c < nConts; c += stride) {
+            const Continent* cont = (*continents)[c];
+            const std::vector<Territory*>* terrs = cont->getTerritories();
+            for (auto t : *terrs) {
+                if (t->getStore() == store) stamp[t->getIndex()] = c;
+            }
+            walk.reset();
+            for (auto t : *terrs) {
+                if (t->getStore() != store) continue;
+                int count = walk.run(t->getIndex(), GraphTraversal::BreadthFirst,
+                                     [&stamp, c](int slot) { return stamp[slot] == c; });
+                if (count > 0) contComps[c].push_back(lastComponent(walk, count, *store));
             }
         }
+    };
+
+    const int threads = validationThreads(options);
+    if (threads <= 1) {
+        wholeMap();
+        borders();
+        continentsFrom(0, 1);
+    } else {
+        runValidationTasks(options, std::max(1, std::min(threads - 2, nConts)),
+                           { wholeMap, borders }, continentsFrom);
     }
 
-    std::cout << " Map validation passed.\n";
-    return true;
+    if (mapComps.size() > 1) {
+        sortComponents(mapComps);
+        add(ValidationIssue::DisconnectedMap, -1, -1, -1, (int)mapComps.size(),
+            " Validation failed: map has " + std::to_string(mapComps.size())
+            + " disconnected components (largest has " + std::to_string(mapComps.front().size())
+            + " territories).");
+        report.mapComponents.swap(mapComps);
+    }
+    for (int c = 0; c < nConts; c++) {
+        if (contComps[c].size() <= 1) continue;
+        Continent* cont = (*continents)[c];
+        sortComponents(contComps[c]);
+        add(ValidationIssue::DisconnectedContinent, -1, -1, cont->getId(), (int)contComps[c].size(),
+            " Validation failed: continent " + cont->getName() + " has "
+            + std::to_string(contComps[c].size()) + " disconnected components.");
+        report.continentComponents.push_back(std::make_pair(cont->getId(), std::vector<std::vector<int>>()));
+        report.continentComponents.back().second.swap(contComps[c]);
+    }
+    for (auto& edge : oneWay) {
+        add(ValidationIssue::AsymmetricBorder, edge.first, edge.second, -1, 0,
+            " Validation warning: border " + std::to_string(edge.first) + " -> "
+            + std::to_string(edge.second) + " has no matching " + std::to_string(edge.second)
+            + " -> " + std::to_string(edge.first) + ".");
+    }
+
+    if (options.log) report.print(std::cout);
+    return report;
 }
 
 // Quick dump of the map contents for debugging
@@ -473,6 +1518,36 @@ std::ostream& operator<<(std::ostream& out, const Map& m) {
     return out;
 }
 
+// ============================================================================
+// Border wiring for the loaders
+// ============================================================================
+// Territory::addAdjacentTerritory compares IDs against the whole neighbor
+// vector per call, which makes a border line O(d^2). The loaders instead
+// check short neighbor lists by pointer, and once a territory has many
+// neighbors they switch it to a hashed edge set so hubs stay O(1) per border.
+
+namespace {
+    class BorderLinker {
+    private:
+        static const std::size_t SMALL_DEGREE = 16;
+        EdgeSet linked;   // pairs for territories past SMALL_DEGREE only
+
+    public:
+        void link(Territory* from, Territory* to) {
+            std::vector<Territory*>* adj = from->getAdjacentTerritories();
+            if (adj->size() < SMALL_DEGREE) {
+                for (auto t : *adj) if (t == to) return;
+                adj->push_back(to);
+                if (adj->size() == SMALL_DEGREE) {
+                    for (auto t : *adj) linked.insert(from->getIndex(), t->getIndex());
+                }
+            } else if (linked.insert(from->getIndex(), to->getIndex())) {
+                adj->push_back(to);
+            }
+        }
+    };
+}
+
 // ============================================================================
 // MapLoader Implementation
 // ============================================================================
@@ -481,11 +1556,14 @@ std::ostream& operator<<(std::ostream& out, const Map& m) {
 
 MapLoader::MapLoader() {
     map = new Map();
+    validated = false;
 }
 
 // Copy constructor: deep-copy the map (so two loaders don’t share one Map*)
 MapLoader::MapLoader(const MapLoader& other) {
     map = other.map ? new Map(*other.map) : new Map();
+    stats = other.stats;
+    validated = other.validated;
 }
 
 // Assignment operator: deep copy, clean previous
@@ -493,6 +1571,8 @@ MapLoader& MapLoader::operator=(const MapLoader& other) {
     if (this != &other) {
         delete map;
         map = other.map ? new Map(*other.map) : new Map();
+        stats = other.stats;
+        validated = other.validated;
     }
     return *this;
 }
@@ -505,6 +1585,10 @@ Map* MapLoader::getMap() const {
     return map;
 }
 
+const MapLoadStats& MapLoader::getLastLoadStats() const {
+    return stats;
+}
+
 // --------------------------------------------------------------------------
 // loadMap: parse the file into [continents], [territories], [borders]
 // Territory lines expected format (based on your working tests):
@@ -529,6 +1613,7 @@ bool MapLoader::loadMap(const std::string& filename) {
     // reset map each load to avoid stale state
     delete map;
     map = new Map();
+    validated = false;
 
     std::ifstream file(filename);
     if (!file.is_open()) {
@@ -612,6 +1697,7 @@ bool MapLoader::loadMap(const std::string& filename) {
     file.close();
 
     // After we've created all territories, wire up adjacency using ID lookups
+    BorderLinker linker;
     for (auto& border : borders) {
         int territoryId = border.first;
         if (!territoryLookup.count(territoryId)) {
@@ -626,11 +1712,701 @@ bool MapLoader::loadMap(const std::string& filename) {
                           << " for territory: " << territoryId << "\n";
                 return false;
             }
-            territory->addAdjacentTerritory(territoryLookup[neighborId]);
+            linker.link(territory, territoryLookup[neighborId]);
         }
     }
 
+    // Freeze the borders into the CSR index used by validation/adjacency checks
+    map->buildAdjacencyIndex();
+
     std::cout << "Map loading completed. Validating...\n";
-    return map->validate();
+    validated = map->validate();
+    return validated;
+}
+
+
+
+// ============================================================================
+// Memory-mapped loader path
+// ============================================================================
+// Same file format as loadMap(filename), but the whole file is mapped
+// read-only and scanned in place: no std::getline, no istringstream per line,
+// no per-token std::string except the names we actually keep.
+
+namespace {
+    // Read-only view of a whole file. mmap on POSIX, plain read elsewhere.
+    class MappedFile {
+    private:
+        const char* data_;
+        std::size_t size_;
+        bool mapped_;
+        std::vector<char> buffer_;
+
+    public:
+        MappedFile() : data_(nullptr), size_(0), mapped_(false) {}
+        ~MappedFile() {
+#ifndef _WIN32
+            if (mapped_) munmap(const_cast<char*>(data_), size_);
+#endif
+        }
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool open(const std::string& filename) {
+#ifndef _WIN32
+            int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd < 0) return false;
+            struct stat st;
+            if (fstat(fd, &st) != 0) { ::close(fd); return false; }
+            size_ = (std::size_t)st.st_size;
+            if (size_ > 0) {
+                void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED) { ::close(fd); return false; }
+                madvise(p, size_, MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(p);
+                mapped_ = true;
+            }
+            ::close(fd);
+            return true;
+#else
+            std::ifstream in(filename, std::ios::binary);
+            if (!in) return false;
+            buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            data_ = buffer_.data();
+            size_ = buffer_.size();
+            return true;
+#endif
+        }
+
+        const char* data() const { return data_; }
+        std::size_t size() const { return size_; }
+    };
+
+    // Hand-rolled tokenizer over one line [cur, end)
+    struct LineScanner {
+        const char* cur;
+        const char* end;
+
+        void skipSpace() {
+            while (cur < end && (*cur == ' ' || *cur == '\t')) ++cur;
+        }
+        bool atEnd() {
+            skipSpace();
+            return cur >= end;
+        }
+        // Identifier = any run of non-blank characters
+        bool identifier(const char*& first, std::size_t& len) {
+            skipSpace();
+            first = cur;
+            while (cur < end && *cur != ' ' && *cur != '\t') ++cur;
+            len = (std::size_t)(cur - first);
+            return len > 0;
+        }
+        // Optional sign followed by digits; must end at a blank or end of line
+        bool integer(int& out) {
+            skipSpace();
+            const char* p = cur;
+            bool neg = false;
+            if (p < end && (*p == '-' || *p == '+')) { neg = (*p == '-'); ++p; }
+            if (p >= end || *p < '0' || *p > '9') return false;
+            long long v = 0;
+            while (p < end && *p >= '0' && *p <= '9') {
+                v = v * 10 + (*p - '0');
+                if (v > 2147483647LL) return false;
+                ++p;
+            }
+            if (p < end && *p != ' ' && *p != '\t') return false;
+            cur = p;
+            out = neg ? (int)-v : (int)v;
+            return true;
+        }
+    };
+
+    bool lineIs(const char* first, std::size_t len, const char* literal) {
+        std::size_t n = std::strlen(literal);
+        return len == n && std::memcmp(first, literal, n) == 0;
+    }
+}
+
+// Post-load validate() shared by the mmap and binary paths
+bool MapLoader::runValidation(const MapLoadOptions& options) {
+    ValidationOptions check;
+    check.threads = 1;
+    check.log = !options.silent;
+    validated = map->validate(check);
+    if (!validated) stats.error = "map failed validation";
+    return validated;
 }
 
+bool MapLoader::loadMap(const std::string& filename, const MapLoadOptions& options) {
+    // reset map each load to avoid stale state
+    delete map;
+    map = new Map();
+    stats = MapLoadStats();
+    validated = false;
+
+    const bool quiet = options.quiet || options.silent;
+
+    // Every failure goes through here: recorded in stats.error, printed unless silent
+    std::ostringstream err;
+    auto fail = [&]() {
+        stats.error = err.str();
+        if (!options.silent) std::cout << stats.error << "\n";
+        return false;
+    };
+
+    auto started = std::chrono::steady_clock::now();
+
+    MappedFile file;
+    if (!file.open(filename)) {
+        err << "Failed to open file: " << filename;
+        return fail();
+    }
+    stats.bytes = file.size();
+
+    enum Section { NONE, CONTINENTS, TERRITORIES, BORDERS };
+    Section section = NONE;
+
+    std::unordered_map<int, Continent*> continentLookup; // by continent ID
+    std::unordered_map<int, Territory*> territoryLookup; // by territory ID
+    std::unordered_map<int, int> continentSlot;          // continent ID -> store index
+
+    // Borders are kept flat until every territory exists:
+    //   borderIds[k] has neighbors borderNeighbors[borderStart[k] .. borderStart[k+1])
+    std::vector<int> borderIds, borderLines, borderStart, borderNeighbors;
+
+    // Rough upper bound on the territory count (a territory plus its border
+    // line take well over 32 bytes) so the lookups don't rehash while growing
+    const std::size_t estimate = file.size() / 32 + 16;
+    territoryLookup.reserve(estimate);
+    map->getStore()->reserve((int)estimate);
+
+    const char* p = file.data();
+    const char* end = p + file.size();
+    int lineNo = 0;
+
+    while (p < end) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', (std::size_t)(end - p)));
+        const char* lineEnd = nl ? nl : end;
+        const char* lineStart = p;
+        p = nl ? nl + 1 : end;
+        ++lineNo;
+        if (lineEnd > lineStart && lineEnd[-1] == '\r') --lineEnd;  // CRLF files
+
+        std::size_t lineLen = (std::size_t)(lineEnd - lineStart);
+        // Ignore empty lines and comments
+        if (lineLen == 0 || lineStart[0] == ';') continue;
+
+        // Section headers
+        if (lineIs(lineStart, lineLen, "[continents]")) { section = CONTINENTS; continue; }
+        if (lineIs(lineStart, lineLen, "[territories]")) { section = TERRITORIES; continue; }
+        if (lineIs(lineStart, lineLen, "[borders]")) { section = BORDERS; continue; }
+
+        LineScanner sc{lineStart, lineEnd};
+
+        // -------------------- CONTINENTS --------------------
+        if (section == CONTINENTS) {
+            const char* nameP; std::size_t nameLen;
+            int id;
+            if (!sc.identifier(nameP, nameLen) || !sc.integer(id)) {
+                err << "Failed to parse continent at line " << lineNo << ": "
+                    << std::string(lineStart, lineLen);
+                return fail();
+            }
+            std::string name(nameP, nameLen);
+            Continent* c = new Continent(name, id, new std::vector<Territory*>());
+            map->addContinent(c);
+            continentLookup[id] = c;
+            continentSlot[id] = -1;
+            if (!quiet) std::cout << "Added continent: " << name << " (ID: " << id << ")\n";
+        }
+        // -------------------- TERRITORIES --------------------
+        else if (section == TERRITORIES) {
+            int id, contId, armies;
+            const char* nameP; std::size_t nameLen;
+            const char* ownerP; std::size_t ownerLen;
+            if (!sc.integer(id) || !sc.identifier(nameP, nameLen) || !sc.integer(contId)
+                || !sc.identifier(ownerP, ownerLen) || !sc.integer(armies)) {
+                err << "Failed to parse territory at line " << lineNo << ": "
+                    << std::string(lineStart, lineLen);
+                return fail();
+            }
+            auto cit = continentLookup.find(contId);
+            if (cit == continentLookup.end()) {
+                err << "Invalid continent ID: " << contId << " for territory: "
+                    << std::string(nameP, nameLen) << " at line " << lineNo;
+                return fail();
+            }
+            if (territoryLookup.count(id)) {
+                err << "Duplicate territory ID: " << id << " at line " << lineNo;
+                return fail();
+            }
+            // Create straight in the map's store (no private store to adopt from)
+            int& contIdx = continentSlot[contId];
+            if (contIdx < 0) contIdx = map->getStore()->internContinent(cit->second->getName());
+            int ownerIdx = map->getStore()->internOwner(std::string(ownerP, ownerLen));
+            Territory* t = map->getStore()->create(std::string(nameP, nameLen), contIdx,
+                                                   ownerIdx, armies, id);
+            map->addTerritory(t);
+            territoryLookup[id] = t;
+            cit->second->addTerritory(t);
+            stats.territories++;
+            if (!quiet) {
+                std::cout << "Added territory: " << t->getName() << " to continent ID: " << contId << "\n";
+            }
+        }
+        // -------------------- BORDERS --------------------
+        else if (section == BORDERS) {
+            int id;
+            if (!sc.integer(id)) {
+                err << "Failed to parse border at line " << lineNo << ": "
+                    << std::string(lineStart, lineLen);
+                return fail();
+            }
+            borderIds.push_back(id);
+            borderLines.push_back(lineNo);
+            borderStart.push_back((int)borderNeighbors.size());
+            int neighborId;
+            while (!sc.atEnd()) {
+                if (!sc.integer(neighborId)) {
+                    err << "Failed to parse border at line " << lineNo << ": "
+                        << std::string(lineStart, lineLen);
+                    return fail();
+                }
+                borderNeighbors.push_back(neighborId);
+            }
+            if (!quiet) {
+                std::cout << "Border for territory " << id << " has "
+                          << borderNeighbors.size() - borderStart.back() << " neighbors\n";
+            }
+        }
+    }
+    stats.lines = lineNo;
+    borderStart.push_back((int)borderNeighbors.size());
+
+    // After we've created all territories, wire up adjacency using ID lookups
+    BorderLinker linker;
+    for (std::size_t k = 0; k < borderIds.size(); k++) {
+        auto tit = territoryLookup.find(borderIds[k]);
+        if (tit == territoryLookup.end()) {
+            err << "Invalid territory ID in borders: " << borderIds[k]
+                << " at line " << borderLines[k];
+            return fail();
+        }
+        for (int j = borderStart[k]; j < borderStart[k + 1]; j++) {
+            auto nit = territoryLookup.find(borderNeighbors[j]);
+            if (nit == territoryLookup.end()) {
+                err << "Invalid neighbor ID: " << borderNeighbors[j]
+                    << " for territory: " << borderIds[k] << " at line " << borderLines[k];
+                return fail();
+            }
+            linker.link(tit->second, nit->second);
+        }
+    }
+    stats.borders = (int)borderNeighbors.size();
+
+    // Freeze the borders into the CSR index used by validation/adjacency checks
+    map->buildAdjacencyIndex();
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    if (!quiet) {
+        std::cout << "Map loading completed: " << stats.bytes << " bytes, "
+                  << stats.territories << " territories in " << stats.seconds * 1000.0
+                  << " ms (" << stats.megabytesPerSecond() << " MB/s).\n";
+    }
+
+    if (!options.validate) return true;
+    if (!quiet) std::cout << "Validating...\n";
+    return runValidation(options);
+}
+
+
+// ============================================================================
+// Binary map format (version 1)
+// ============================================================================
+// All integers are 32-bit in host byte order (the header carries a byte-order
+// mark so a file from a different-endian machine is rejected, not misread).
+//
+//   header      magic "WZMAPBIN", version, byteOrder, flags (bit 0 = validated),
+//               continentCount, territoryCount, edgeCount, memberCount,
+//               stringCount, stringBytes, checksum (64-bit FNV-1a of the payload)
+//   payload     string offsets   u32[stringCount + 1]
+//               string bytes     char[stringBytes], zero-padded to 4
+//               continents       {i32 id, u32 name}[continentCount]
+//               territories      {i32 id, u32 name, u32 continent, u32 owner, i32 armies}[territoryCount]
+//               border CSR       u32 offsets[territoryCount + 1], u32 targets[edgeCount]
+//               members CSR      u32 offsets[continentCount + 1], u32 members[memberCount]
+//
+// Territory/continent references are record indices, strings are table indices.
+
+namespace {
+    const char BINARY_MAGIC[8] = {'W', 'Z', 'M', 'A', 'P', 'B', 'I', 'N'};
+    const unsigned BINARY_VERSION = 1;
+    const unsigned BINARY_BYTE_ORDER = 0x01020304u;
+    const unsigned BINARY_FLAG_VALIDATED = 1u;
+
+    struct BinaryHeader {
+        char magic[8];
+        unsigned version;
+        unsigned byteOrder;
+        unsigned flags;
+        unsigned continentCount;
+        unsigned territoryCount;
+        unsigned edgeCount;
+        unsigned memberCount;
+        unsigned stringCount;
+        unsigned stringBytes;
+        unsigned reserved;
+        unsigned long long checksum;
+    };
+
+    struct BinaryContinent {
+        int id;
+        unsigned name;
+    };
+
+    struct BinaryTerritory {
+        int id;
+        unsigned name;
+        unsigned continent;
+        unsigned owner;
+        int armies;
+    };
+
+    unsigned long long fnv1a(const char* data, std::size_t len) {
+        unsigned long long h = 14695981039346656037ULL;   // FNV-1a 64-bit offset basis
+        for (std::size_t i = 0; i < len; i++) {
+            h ^= (unsigned char)data[i];
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    template <typename T>
+    void appendPod(std::vector<char>& out, const T* items, std::size_t count) {
+        const char* p = reinterpret_cast<const char*>(items);
+        out.insert(out.end(), p, p + sizeof(T) * count);
+    }
+
+    // Bounds-checked cursor over the mapped payload
+    struct BinaryReader {
+        const char* cur;
+        const char* end;
+
+        template <typename T>
+        const T* take(std::size_t count) {
+            std::size_t bytes = sizeof(T) * count;
+            if ((std::size_t)(end - cur) < bytes) return nullptr;
+            const T* p = reinterpret_cast<const T*>(cur);
+            cur += bytes;
+            return p;
+        }
+    };
+}
+
+bool MapLoader::saveBinary(const std::string& filename) const {
+    // The validated flag describes the map being saved, not the last load:
+    // it may have been edited since (and trusted loads skip validation)
+    ValidationOptions check;
+    check.log = false;
+    const bool valid = map->validate(check);
+
+    const Map& source = *map;   // read-only: keeps the map's ID indexes
+    const std::vector<Territory*>& terrs = *source.getTerritories();
+    const std::vector<Continent*>& conts = *source.getContinents();
+    TerritoryStore* store = map->getStore();
+
+    // String table (names, owners) with de-duplication
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, unsigned> stringIndex;
+    auto intern = [&](const std::string& str) {
+        auto it = stringIndex.find(str);
+        if (it != stringIndex.end()) return it->second;
+        unsigned idx = (unsigned)strings.size();
+        strings.push_back(str);
+        stringIndex[str] = idx;
+        return idx;
+    };
+
+    // Record index for every territory slot / continent name
+    std::vector<int> recordOfSlot(store->size(), -1);
+    for (std::size_t i = 0; i < terrs.size(); i++) recordOfSlot[terrs[i]->getIndex()] = (int)i;
+    std::unordered_map<std::string, unsigned> continentRecord;
+
+    std::vector<BinaryContinent> contRecs;
+    contRecs.reserve(conts.size());
+    for (std::size_t c = 0; c < conts.size(); c++) {
+        BinaryContinent rec;
+        rec.id = conts[c]->getId();
+        rec.name = intern(conts[c]->getName());
+        contRecs.push_back(rec);
+        continentRecord.insert(std::make_pair(conts[c]->getName(), (unsigned)c));
+    }
+
+    std::vector<BinaryTerritory> terrRecs;
+    terrRecs.reserve(terrs.size());
+    std::vector<unsigned> borderOffsets(1, 0), borderTargets;
+    for (auto t : terrs) {
+        BinaryTerritory rec;
+        rec.id = t->getId();
+        rec.name = intern(t->getName());
+        auto cit = continentRecord.find(t->getContinent());
+        rec.continent = cit == continentRecord.end() ? 0xFFFFFFFFu : cit->second;
+        rec.owner = intern(t->getOwner());
+        rec.armies = t->getArmies();
+        terrRecs.push_back(rec);
+
+        for (auto nb : *t->getAdjacentTerritories()) {
+            if (nb->getStore() == store && recordOfSlot[nb->getIndex()] >= 0) {
+                borderTargets.push_back((unsigned)recordOfSlot[nb->getIndex()]);
+            }
+        }
+        borderOffsets.push_back((unsigned)borderTargets.size());
+    }
+
+    std::vector<unsigned> memberOffsets(1, 0), members;
+    for (const Continent* c : conts) {
+        for (auto t : *c->getTerritories()) {
+            if (t->getStore() == store && recordOfSlot[t->getIndex()] >= 0) {
+                members.push_back((unsigned)recordOfSlot[t->getIndex()]);
+            }
+        }
+        memberOffsets.push_back((unsigned)members.size());
+    }
+
+    std::vector<unsigned> stringOffsets(1, 0);
+    std::string blob;
+    for (auto& str : strings) {
+        blob += str;
+        stringOffsets.push_back((unsigned)blob.size());
+    }
+    while (blob.size() % 4) blob.push_back('\0');
+
+    std::vector<char> payload;
+    appendPod(payload, stringOffsets.data(), stringOffsets.size());
+    payload.insert(payload.end(), blob.begin(), blob.end());
+    appendPod(payload, contRecs.data(), contRecs.size());
+    appendPod(payload, terrRecs.data(), terrRecs.size());
+    appendPod(payload, borderOffsets.data(), borderOffsets.size());
+    appendPod(payload, borderTargets.data(), borderTargets.size());
+    appendPod(payload, memberOffsets.data(), memberOffsets.size());
+    appendPod(payload, members.data(), members.size());
+
+    BinaryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    header.version = BINARY_VERSION;
+    header.byteOrder = BINARY_BYTE_ORDER;
+    header.flags = valid ? BINARY_FLAG_VALIDATED : 0u;
+    header.continentCount = (unsigned)contRecs.size();
+    header.territoryCount = (unsigned)terrRecs.size();
+    header.edgeCount = (unsigned)borderTargets.size();
+    header.memberCount = (unsigned)members.size();
+    header.stringCount = (unsigned)strings.size();
+    header.stringBytes = (unsigned)blob.size();
+    header.checksum = fnv1a(payload.data(), payload.size());
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cout << "Failed to open file for writing: " << filename << "\n";
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(payload.data(), (std::streamsize)payload.size());
+    return (bool)out;
+}
+
+bool MapLoader::loadBinary(const std::string& filename, const MapLoadOptions& options) {
+    // reset map each load to avoid stale state
+    delete map;
+    map = new Map();
+    stats = MapLoadStats();
+    validated = false;
+
+    const bool quiet = options.quiet || options.silent;
+
+    // Every failure goes through here: recorded in stats.error, printed unless silent
+    std::ostringstream err;
+    auto fail = [&]() {
+        stats.error = err.str();
+        if (!options.silent) std::cout << stats.error << "\n";
+        return false;
+    };
+
+    auto started = std::chrono::steady_clock::now();
+
+    MappedFile file;
+    if (!file.open(filename)) {
+        err << "Failed to open file: " << filename;
+        return fail();
+    }
+    stats.bytes = file.size();
+
+    BinaryHeader header;
+    if (file.size() < sizeof(header)) {
+        err << "Not a binary map (file too small): " << filename;
+        return fail();
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+        err << "Not a binary map (bad magic): " << filename;
+        return fail();
+    }
+    if (header.byteOrder != BINARY_BYTE_ORDER || header.version != BINARY_VERSION) {
+        err << "Unsupported binary map version " << header.version << ": " << filename;
+        return fail();
+    }
+
+    const char* payload = file.data() + sizeof(header);
+    const std::size_t payloadSize = file.size() - sizeof(header);
+    if (fnv1a(payload, payloadSize) != header.checksum) {
+        err << "Binary map checksum mismatch: " << filename;
+        return fail();
+    }
+
+    // Every section size is checked against the payload before anything is
+    // read or allocated. Counts are widened first, so a count of 0xFFFFFFFF
+    // can't wrap a "+ 1" to an empty section.
+    const std::size_t needed = sizeof(unsigned) * ((std::size_t)header.stringCount + 1)
+                             + (std::size_t)header.stringBytes
+                             + sizeof(BinaryContinent) * (std::size_t)header.continentCount
+                             + sizeof(BinaryTerritory) * (std::size_t)header.territoryCount
+                             + sizeof(unsigned) * ((std::size_t)header.territoryCount + 1)
+                             + sizeof(unsigned) * (std::size_t)header.edgeCount
+                             + sizeof(unsigned) * ((std::size_t)header.continentCount + 1)
+                             + sizeof(unsigned) * (std::size_t)header.memberCount;
+    if (needed > payloadSize) {
+        err << "Binary map is truncated: " << filename;
+        return fail();
+    }
+
+    BinaryReader rd{payload, payload + payloadSize};
+    const unsigned* stringOffsets = rd.take<unsigned>((std::size_t)header.stringCount + 1);
+    const char* blob = rd.take<char>(header.stringBytes);
+    const BinaryContinent* contRecs = rd.take<BinaryContinent>(header.continentCount);
+    const BinaryTerritory* terrRecs = rd.take<BinaryTerritory>(header.territoryCount);
+    const unsigned* borderOffsets = rd.take<unsigned>((std::size_t)header.territoryCount + 1);
+    const unsigned* borderTargets = rd.take<unsigned>(header.edgeCount);
+    const unsigned* memberOffsets = rd.take<unsigned>((std::size_t)header.continentCount + 1);
+    const unsigned* members = rd.take<unsigned>(header.memberCount);
+    if (!stringOffsets || !blob || !contRecs || !terrRecs || !borderOffsets
+        || !borderTargets || !memberOffsets || !members) {
+        err << "Binary map is truncated: " << filename;
+        return fail();
+    }
+
+    const unsigned nT = header.territoryCount;
+    const unsigned nC = header.continentCount;
+    auto str = [&](unsigned i) {
+        return std::string(blob + stringOffsets[i], stringOffsets[i + 1] - stringOffsets[i]);
+    };
+    // Cheap structural checks so a corrupt-but-checksummed file can't index out of range
+    for (unsigned i = 0; i < header.stringCount; i++) {
+        if (stringOffsets[i] > stringOffsets[i + 1] || stringOffsets[i + 1] > header.stringBytes) {
+            err << "Binary map has a bad string table: " << filename;
+            return fail();
+        }
+    }
+    if (borderOffsets[nT] != header.edgeCount || memberOffsets[nC] != header.memberCount) {
+        err << "Binary map has bad section sizes: " << filename;
+        return fail();
+    }
+    // Both CSR offset arrays in full before any loop reads through them:
+    // non-decreasing, and (with the last one checked above) never past the end
+    for (unsigned i = 0; i < nT; i++) {
+        if (borderOffsets[i] > borderOffsets[i + 1]) {
+            err << "Binary map has bad border offsets: " << filename;
+            return fail();
+        }
+    }
+    for (unsigned c = 0; c < nC; c++) {
+        if (memberOffsets[c] > memberOffsets[c + 1]) {
+            err << "Binary map has bad member offsets: " << filename;
+            return fail();
+        }
+    }
+
+    // Continents
+    for (unsigned c = 0; c < nC; c++) {
+        if (contRecs[c].name >= header.stringCount) {
+            err << "Binary map has a bad continent record: " << filename;
+            return fail();
+        }
+        map->continents->push_back(new Continent(str(contRecs[c].name), contRecs[c].id,
+                                                 new std::vector<Territory*>()));
+    }
+
+    // Territories straight into the store, interning each distinct string once
+    TerritoryStore* store = map->store;
+    store->reserve((int)nT);
+    map->territories->reserve(nT);
+    std::vector<int> ownerIdxOf(header.stringCount, -1);
+    std::vector<int> contIdxOf(nC, -1);
+    std::vector<Territory*> byRecord(nT, nullptr);
+    for (unsigned i = 0; i < nT; i++) {
+        const BinaryTerritory& rec = terrRecs[i];
+        if (rec.name >= header.stringCount || rec.owner >= header.stringCount
+            || (rec.continent >= nC && rec.continent != 0xFFFFFFFFu)) {
+            err << "Binary map has a bad territory record: " << filename;
+            return fail();
+        }
+        if (ownerIdxOf[rec.owner] < 0) ownerIdxOf[rec.owner] = store->internOwner(str(rec.owner));
+        int contIdx;
+        if (rec.continent == 0xFFFFFFFFu) {
+            contIdx = store->internContinent("Unknown");
+        } else {
+            if (contIdxOf[rec.continent] < 0) {
+                contIdxOf[rec.continent] = store->internContinent(str(contRecs[rec.continent].name));
+            }
+            contIdx = contIdxOf[rec.continent];
+        }
+        Territory* t = store->create(str(rec.name), contIdx, ownerIdxOf[rec.owner], rec.armies, rec.id);
+        map->territories->push_back(t);
+        byRecord[i] = t;
+    }
+
+    // Borders from the CSR section
+    for (unsigned i = 0; i < nT; i++) {
+        std::vector<Territory*>* adj = byRecord[i]->getAdjacentTerritories();
+        adj->reserve(borderOffsets[i + 1] - borderOffsets[i]);
+        for (unsigned k = borderOffsets[i]; k < borderOffsets[i + 1]; k++) {
+            if (borderTargets[k] >= nT) {
+                err << "Binary map has a bad border target: " << filename;
+                return fail();
+            }
+            adj->push_back(byRecord[borderTargets[k]]);
+        }
+    }
+
+    // Continent membership lists
+    for (unsigned c = 0; c < nC; c++) {
+        std::vector<Territory*>* list = (*map->continents)[c]->getTerritories();
+        list->reserve(memberOffsets[c + 1] - memberOffsets[c]);
+        for (unsigned k = memberOffsets[c]; k < memberOffsets[c + 1]; k++) {
+            if (members[k] >= nT) {
+                err << "Binary map has a bad continent member: " << filename;
+                return fail();
+            }
+            list->push_back(byRecord[members[k]]);
+        }
+    }
+
+    map->buildAdjacencyIndex();
+
+    stats.lines = 0;
+    stats.territories = (int)nT;
+    stats.borders = (int)header.edgeCount;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    if (!quiet) {
+        std::cout << "Binary map loaded: " << stats.bytes << " bytes, " << nT << " territories in "
+                  << stats.seconds * 1000.0 << " ms (" << stats.megabytesPerSecond() << " MB/s).\n";
+    }
+
+    const bool flaggedValid = (header.flags & BINARY_FLAG_VALIDATED) != 0;
+    if (options.trusted && flaggedValid) {
+        validated = true;
+        return true;
+    }
+    if (!options.validate) return true;
+    return runValidation(options);
+}
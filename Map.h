@@ -1,31 +1,414 @@
 #ifndef MAP_H
 #define MAP_H
 
+#include <atomic>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+// ============================================================================
+// TerritoryStore (struct-of-arrays)
+// ============================================================================
+// The hot per-territory fields live here in parallel, contiguous arrays so a
+// full-map scan (armies, owners, continents, ids) walks memory linearly
+// instead of chasing one heap pointer per field per territory.
+//  - slot i in every array describes the same territory
+//  - owner/continent names are interned; territories store a small index
+//  - handles[i] is the Territory object bound to slot i
+// A Map owns one store for all its territories. A Territory created on its
+// own (drivers, order copies) owns a private 1-slot store until a Map adopts it.
+
+class Territory;
+class OwnershipIndex;
+
+// Read-only view over a contiguous run of neighbor slots (C++14 has no std::span)
+struct NeighborRange {
+    const int* first;
+    const int* last;
+
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    int size() const { return (int)(last - first); }
+    bool empty() const { return first == last; }
+    int operator[](int i) const { return first[i]; }
+};
+
+// Open-addressing hash set of directed edges (a, b), used as the adjacency
+// index on maps too big for a dense bitset. Keys are packed into one 64-bit
+// word; 0 marks an empty bucket.
+class EdgeSet {
+private:
+    std::vector<unsigned long long> buckets;
+    unsigned long long mask;
+    std::size_t count;
+
+    void grow();
+
+    static unsigned long long key(int a, int b) {
+        return ((unsigned long long)(unsigned)a << 32 | (unsigned)b) + 1;
+    }
+    static unsigned long long hash(unsigned long long k) {
+        k ^= k >> 33; k *= 0xff51afd7ed558ccdULL; k ^= k >> 33;
+        return k;
+    }
+
+public:
+    EdgeSet() : mask(0), count(0) {}
+    void reset(int edgeCount);
+    bool insert(int a, int b);   // false if (a, b) was already present
+    bool contains(int a, int b) const;
+    void clear() { buckets.clear(); mask = 0; count = 0; }
+};
+
+// Undo log for a store's per-game values. While one is attached to a store
+// (TerritoryStore::setJournal), every armies/owner change appends the slot's
+// old value, so going back to a mark costs O(changes since the mark), not
+// O(map). Marks nest. Entries are store slots: adding or removing
+// territories empties the journal.
+//   StateJournal journal;
+//   store->setJournal(&journal);
+//   StateJournal::Mark m = journal.mark();
+//   ... execute orders ...
+//   store->rollback(m);            // or ExecutionContext::rollback (players too)
+class StateJournal {
+public:
+    enum Field : unsigned char { Armies, Owner };
+    struct Entry {
+        int slot;
+        int value;     // before the change (owner: interned owner index)
+        Field field;
+    };
+    typedef std::size_t Mark;
+
+    Mark mark() const { return entries.size(); }
+    std::size_t size() const { return entries.size(); }
+    void record(Field field, int slot, int value) { entries.push_back(Entry{slot, value, field}); }
+    const Entry& back() const { return entries.back(); }
+    void pop() { entries.pop_back(); }
+    void clear() { entries.clear(); }   // keeps capacity for the next trial
+
+private:
+    std::vector<Entry> entries;
+};
+
+class TerritoryStore {
+private:
+    std::vector<int> ids;
+    std::vector<int> armies;
+    std::vector<int> owners;       // index into ownerNames
+    std::vector<int> continents;   // index into continentNames
+    std::vector<std::string> names;
+    std::vector<Territory*> handles;
+
+    std::vector<std::string> ownerNames;
+    std::vector<std::string> continentNames;
+    std::unordered_map<std::string, int> ownerLookup;
+    // Player ids bound to owner indices (GameEngine's registry)
+    std::vector<int> playerOfOwner;    // owner index -> player id, -1 if not a player
+    std::vector<int> ownerOfPlayer;    // player id -> owner index, -1 if unbound
+    std::unordered_map<std::string, int> continentLookup;
+
+    // CSR adjacency: neighbors of slot i are adjTargets[adjOffsets[i] .. adjOffsets[i+1])
+    // Built from the handles' adjacency vectors; topologyVersion bumps on every
+    // slot or border change so a stale index is never used.
+    std::vector<int> adjOffsets;
+    std::vector<int> adjTargets;
+    unsigned topologyVersion;
+    unsigned adjacencyVersion;
+    bool adjacencyBuilt;
+
+    // O(1) "is a next to b": a dense n*n bitset while that stays small,
+    // otherwise a hashed edge set. nameSlots maps a name to its slot
+    // (-2 when the name is used by more than one territory).
+    std::vector<unsigned long long> adjBits;
+    EdgeSet adjEdges;
+    std::unordered_map<std::string, int> nameSlots;
+
+    // Bumps whenever a territory's ID changes, in any store. Map's and
+    // Continent's ID indexes compare it before trusting themselves, the way
+    // the CSR index checks topologyVersion. It's process-wide because a
+    // continent's members can sit in several stores (a territory keeps a
+    // private one until a map adopts it).
+    static std::atomic<unsigned> idVersion;
+
+public:
+    TerritoryStore();
+    TerritoryStore(const TerritoryStore& other) = delete;
+    TerritoryStore& operator=(const TerritoryStore& other) = delete;
+    ~TerritoryStore();
+
+    // Slot management
+    int append(const std::string& name, const std::string& continent,
+               const std::string& owner, int armies, int id, Territory* handle);
+    // Bulk path: new Territory bound straight to this store, indices pre-interned
+    Territory* create(const std::string& name, int contIdx, int ownerIdx, int armies, int id);
+    void release(int slot);        // swap-remove, rebinds the moved handle
+    void adopt(Territory* t);      // move t's data into this store and rebind it
+    void unbindAll();              // detach every handle (used by ~Map)
+    int size() const { return (int)ids.size(); }
+
+    // Interning
+    int internOwner(const std::string& name);
+    int internContinent(const std::string& name);
+    const std::string& ownerName(int ownerIdx) const { return ownerNames[ownerIdx]; }
+    const std::string& continentName(int contIdx) const { return continentNames[contIdx]; }
+    int findOwner(const std::string& name) const;   // -1 if never interned
+    int findContinent(const std::string& name) const;   // -1 if never interned
+    int continentCount() const { return (int)continentNames.size(); }
+    int ownerCount() const { return (int)ownerNames.size(); }
+
+    // Player ids: bindPlayer() interns the player's name and links the two
+    // indices, so ownership can be read and written as a player id.
+    void bindPlayer(int playerId, const std::string& name);
+    void unbindPlayers();
+    bool hasPlayers() const { return !ownerOfPlayer.empty(); }
+    int playerCount() const { return (int)ownerOfPlayer.size(); }   // one past the highest bound id
+    int playerOf(int ownerIdx) const {
+        return ownerIdx < (int)playerOfOwner.size() ? playerOfOwner[ownerIdx] : -1;
+    }
+    int ownerOf(int playerId) const {
+        return playerId >= 0 && playerId < (int)ownerOfPlayer.size() ? ownerOfPlayer[playerId] : -1;
+    }
+
+    // Column access (read-only for scans)
+    const std::vector<int>& getIds() const { return ids; }
+    const std::vector<int>& getArmies() const { return armies; }
+    const std::vector<int>& getOwners() const { return owners; }
+    const std::vector<int>& getContinents() const { return continents; }
+    const std::vector<std::string>& getNames() const { return names; }
+    Territory* handle(int slot) const { return handles[slot]; }
+
+    // Single mutation funnel for per-slot values
+    void setArmies(int slot, int value) {
+        if (journal != nullptr) journal->record(StateJournal::Armies, slot, armies[slot]);
+        armies[slot] = value;
+    }
+    void setOwner(int slot, int ownerIdx);   // keeps the ownership index in step
+    void replaceOwners(std::vector<int> column);   // whole column at once (index rebuilt once)
+    void setContinent(int slot, int contIdx);   // keeps continent control in step
+    void setId(int slot, int value) {
+        if (ids[slot] == value) return;
+        ids[slot] = value;
+        idVersion.fetch_add(1, std::memory_order_relaxed);
+    }
+    void setName(int slot, const std::string& value) { names[slot] = value; }
+
+    void reserve(int n);
+
+    // CSR adjacency index
+    void buildAdjacency();
+    bool hasAdjacency() const { return adjacencyBuilt && adjacencyVersion == topologyVersion; }
+    void ensureAdjacency() { if (!hasAdjacency()) buildAdjacency(); }
+    void touchTopology() {
+        ++topologyVersion;
+        if (journal != nullptr) journal->clear();   // its slots may not mean the same any more
+    }
+    unsigned getTopologyVersion() const { return topologyVersion; }
+    static unsigned getIdVersion() { return idVersion.load(std::memory_order_relaxed); }
+    NeighborRange neighbors(int slot) const {
+        return NeighborRange{adjTargets.data() + adjOffsets[slot], adjTargets.data() + adjOffsets[slot + 1]};
+    }
+    int edgeCount() const { return (int)adjTargets.size(); }
+
+    // Constant-time adjacency queries (valid while hasAdjacency())
+    static const int DENSE_ADJACENCY_LIMIT = 4096;   // n*n bits = 2 MB
+    bool adjacent(int a, int b) const;
+    int slotOfName(const std::string& name) const;   // -1 unknown, -2 ambiguous
+
+    // Owner -> territories, frontier and continents held, built on first use
+    // (and after any topology change), then updated by every setOwner() and
+    // setContinent()
+    const OwnershipIndex& ownershipIndex();
+
+    // Undo journal (not owned; nullptr = changes aren't recorded)
+    void setJournal(StateJournal* j) { journal = j; }
+    StateJournal* getJournal() const { return journal; }
+    void undo(const StateJournal::Entry& e);   // put one entry's old value back (not recorded)
+    void rollback(StateJournal::Mark mark);   // undo the attached journal back to mark
+
+private:
+    OwnershipIndex* ownership;   // nullptr until first asked for
+    StateJournal* journal;
+};
+
+// ============================================================================
+// OwnershipIndex
+// ============================================================================
+// Per owner (interned owner index of the store):
+//  - owned: the territories it holds
+//  - frontier: territories it doesn't hold that are a neighbor of one it
+//    does (what it can attack), counted so a neighbor changing hands is O(1)
+//  - continents: how many territories of each continent (interned continent
+//    index of the store) it holds, and which continents it holds entirely
+// Kept by its TerritoryStore: every ownership change moves one territory
+// between two owned lists and adjusts the counts of its neighbors, so the
+// cost of a change is O(degree) and a query just returns the list.
+// Lists are unordered (removal swaps the last entry in). Counts are dense
+// arrays (8 bytes per territory) for each owner that ever held territory.
+// Continent counts are one int per (owner, continent), updated in O(1) per
+// change, so a reinforcement pass only needs owned(o).size() and
+// controlled(o) for every player.
+
+class OwnershipIndex {
+private:
+    struct Border {
+        int count;   // neighbors owned by this owner that border the slot
+        int pos;     // position in frontier, -1 when not listed
+    };
+
+    const TerritoryStore* store;
+    unsigned version;   // store topology this was built for
+    std::vector<std::vector<Territory*>> ownedBy;        // per owner
+    std::vector<int> ownedPos;                           // per slot: position in ownedBy[owner]
+    std::vector<std::vector<Territory*>> frontierOf;     // per owner
+    std::vector<std::vector<Border>> borders;   // per owner, per slot (empty until used)
+
+    // Continent control
+    std::vector<int> continentSizes;              // per continent
+    std::vector<std::vector<int>> held;           // per owner, per continent
+    std::vector<int> controller;                  // per continent: owner holding all of it, -1 if none
+    std::vector<int> controlPos;                  // per continent: position in controlledBy[controller]
+    std::vector<std::vector<int>> controlledBy;   // per owner
+
+    void grow(int owner);
+    void growContinents(int cont);
+    int& heldBy(int owner, int cont);
+    void settle(int cont, int owner);   // owner's count in cont changed
+    void take(int cont, int owner);
+    void release(int cont);
+    void bump(int owner, int slot, int delta);
+    std::vector<Border>& bordersOf(int owner);
+    void list(int owner, int slot, Border& b);
+    void unlist(int owner, Border& b);
+
+public:
+    OwnershipIndex(const TerritoryStore* store, unsigned version);
+
+    // Recompute everything from the store's owner column and adjacency
+    void rebuild(unsigned version);
+    bool builtFor(unsigned v) const { return version == v; }
+
+    // slot went from owner `from` to owner `to` (store's column already updated)
+    void moved(int slot, int from, int to);
+    // slot went from continent `from` to continent `to` (column already updated)
+    void regrouped(int slot, int from, int to);
+
+    // Empty for owners that hold / border nothing (or were never interned)
+    const std::vector<Territory*>& owned(int owner) const;
+    const std::vector<Territory*>& frontier(int owner) const;
+    bool onFrontier(int owner, int slot) const;
+
+    // Continent control (continents are the store's interned indices)
+    int continentSize(int cont) const;
+    int heldIn(int owner, int cont) const;
+    int controllerOf(int cont) const;                   // -1 if nobody holds all of it
+    const std::vector<int>& controlled(int owner) const;   // unordered
+};
+
+// ============================================================================
+// GraphTraversal
+// ============================================================================
+// Iterative BFS/DFS over a store's CSR adjacency: an explicit frontier
+// (queue or stack) plus a visited bitset, no recursion, no std::function.
+// One object can run many traversals; reset() only clears the bits the last
+// runs set, so per-continent sweeps on a huge map stay O(continent size).
+//   GraphTraversal walk(*store);
+//   walk.run(start, GraphTraversal::BreadthFirst, [&](int slot) { return inMyContinent(slot); });
+//   walk.visited(slot)
+
+class GraphTraversal {
+public:
+    enum Order { BreadthFirst, DepthFirst };
+
+private:
+    const TerritoryStore* store;
+    std::vector<unsigned long long> bits;
+    std::vector<int> frontier;
+    std::vector<int> touched;   // every slot marked since the last reset()
+
+    void mark(int slot) {
+        bits[slot >> 6] |= 1ULL << (slot & 63);
+        touched.push_back(slot);
+    }
+
+public:
+    explicit GraphTraversal(const TerritoryStore& s)
+        : store(&s), bits(((std::size_t)s.size() + 63) / 64, 0) {}
+
+    bool visited(int slot) const { return (bits[slot >> 6] >> (slot & 63)) & 1ULL; }
+    int visitedCount() const { return (int)touched.size(); }
+    // Slots marked since the last reset(), in visit order. The last run()'s
+    // slots are the final run() return value entries.
+    const std::vector<int>& marked() const { return touched; }
+
+    void reset() {
+        for (int slot : touched) bits[slot >> 6] = 0;
+        touched.clear();
+    }
+
+    // Visit everything reachable from start through neighbors for which
+    // keep(slot) is true. Returns how many slots this run marked.
+    template <typename Keep>
+    int run(int start, Order order, Keep keep) {
+        if (visited(start)) return 0;
+        const std::size_t before = touched.size();
+        frontier.clear();
+        frontier.push_back(start);
+        mark(start);
+        std::size_t head = 0;
+        while (order == BreadthFirst ? head < frontier.size() : !frontier.empty()) {
+            int cur;
+            if (order == BreadthFirst) {
+                cur = frontier[head++];
+            } else {
+                cur = frontier.back();
+                frontier.pop_back();
+            }
+            for (int nb : store->neighbors(cur)) {
+                if (!visited(nb) && keep(nb)) {
+                    mark(nb);
+                    frontier.push_back(nb);
+                }
+            }
+        }
+        return (int)(touched.size() - before);
+    }
+
+    int run(int start, Order order = BreadthFirst) {
+        return run(start, order, [](int) { return true; });
+    }
+};
+
 // ============================================================================
 // Territory Class
 // ============================================================================
 // Each Territory has:
 //  - name
 //  - continent (string, not pointer to Continent to keep things simple)
-//  - owner (just a string for now, could be Player later in assignment)
+//  - owner (a name; in a game also a player id, see TerritoryStore::bindPlayer)
 //  - armies
 //  - unique ID
 //  - adjacency list (vector of Territory*)
-// I use raw pointers for all fields to practice Rule of 3.
+// Name/continent/owner/armies/id are not members anymore: a Territory is a
+// handle (store + slot) into a TerritoryStore, so getters read the shared
+// arrays. The adjacency list is still a per-territory heap vector.
 
 class Territory {
+    friend class TerritoryStore;
+
 private:
-    std::string* name;
-    std::string* continent;
-    std::string* owner;
-    int* armies;
-    int* id;
+    TerritoryStore* store;   // where my fields live
+    int slot;                // my index in the store
+    bool ownsStore;          // true for a stand-alone territory
     std::vector<Territory*>* adjacentTerritories;
 
+    void bindPrivateStore(const std::string& name, const std::string& continent,
+                          const std::string& owner, int armies, int id);
+    Territory(TerritoryStore* store, int slot);   // used by TerritoryStore::create
+
 public:
     // Constructors / destructor
     Territory();
@@ -42,11 +425,17 @@ public:
     int getArmies() const;
     int getId() const;
     std::vector<Territory*>* getAdjacentTerritories() const;
+    int getIndex() const { return slot; }           // slot in the owning store
+    int getOwnerIndex() const;                      // interned owner index
+    int getOwnerId() const;                         // owner's player id, -1 if not a bound player
+    TerritoryStore* getStore() const { return store; }
+    bool isOwnedBy(const std::string& ownerName) const;   // no string copy
 
     // Setters
     void setName(std::string name);
     void setContinent(std::string continent);
     void setOwner(std::string owner);
+    void setOwnerId(int playerId);   // bound players only (see TerritoryStore::bindPlayer)
     void setArmies(int armies);
     void setId(int id);
     void setAdjacentTerritories(std::vector<Territory*>* adj);
@@ -83,6 +472,15 @@ private:
     std::string* name;
     int* id;
     std::vector<Territory*>* territories;
+    // IDs of the members, so addTerritory's duplicate check is O(1). The
+    // non-const getTerritories() hands out the vector itself, so it marks the
+    // set stale and the next addTerritory rebuilds it; so does a member's
+    // setId (memberIdsAt is the store ID version the set was built at).
+    std::unordered_set<int>* memberIds;
+    bool memberIdsStale;
+    unsigned memberIdsAt;
+
+    void syncMemberIds();
 
 public:
     Continent();
@@ -94,7 +492,8 @@ public:
     // Getters
     std::string getName() const;
     int getId() const;
-    std::vector<Territory*>* getTerritories() const;
+    std::vector<Territory*>* getTerritories();               // for editing (see memberIds)
+    const std::vector<Territory*>* getTerritories() const;   // read-only: keeps memberIds
 
     // Setters
     void setName(std::string n);
@@ -110,28 +509,162 @@ public:
     friend std::ostream& operator<<(std::ostream& out, const Continent& c);
 };
 
+// ============================================================================
+// MapTopology / MapState
+// ============================================================================
+// A map split in two, for running many games on one map:
+//  - MapTopology: what a game never changes (territory names and ids,
+//    continents, borders). Immutable once built and handed around as a
+//    shared_ptr<const>, so any number of games and threads can share one.
+//  - MapState: what a game does change (owner and armies per territory), as
+//    plain arrays. Copying one is a couple of memcpys.
+// Both number territories by their position in the map's territory list.
+// Borders or continent members that point outside the map are not part of
+// the topology.
+//   auto topo = map.topology();            // once
+//   MapState start = map.saveState();
+//   Map board(topo, start);                // per game, or per worker:
+//   board.loadState(start);                //   ... and reset it per game
+// Copying a Map goes through the same split, so a copy's borders and
+// continents only point at its own territories, and copies of a board
+// built from a topology share it.
+
+class MapTopology {
+public:
+    struct ContinentInfo {
+        std::string name;
+        int id;
+        std::vector<int> members;   // territory numbers
+    };
+
+    int size() const { return (int)names.size(); }
+    const std::string& name(int t) const { return names[t]; }
+    int id(int t) const { return ids[t]; }
+    const std::string& continentOf(int t) const { return continentNames[continentOfTerritory[t]]; }
+    NeighborRange neighbors(int t) const {
+        return NeighborRange{borderTargets.data() + borderOffsets[t], borderTargets.data() + borderOffsets[t + 1]};
+    }
+    int edgeCount() const { return (int)borderTargets.size(); }
+    const std::vector<ContinentInfo>& continents() const { return continentList; }
+
+private:
+    friend class Map;   // built by Map::topology()
+
+    std::vector<std::string> names;
+    std::vector<int> ids;
+    std::vector<int> continentOfTerritory;   // index into continentNames
+    std::vector<std::string> continentNames; // the territories' continent strings
+    std::vector<int> borderOffsets;          // CSR, as in TerritoryStore
+    std::vector<int> borderTargets;
+    std::vector<ContinentInfo> continentList;   // the map's Continent objects, in order
+};
+
+struct MapState {
+    std::vector<int> owners;               // per territory: index into ownerNames
+    std::vector<int> armies;               // per territory
+    std::vector<std::string> ownerNames;
+};
+
 // ============================================================================
 // Map Class
 // ============================================================================
+
+class ThreadPool;
+
+// Knobs for the validation engine (Map::validate(const ValidationOptions&))
+struct ValidationOptions {
+    int threads = 0;              // 0 = one per hardware thread, 1 = serial
+    ThreadPool* pool = nullptr;   // reuse a caller's pool instead of spawning one
+    bool log = true;              // false = no console output at all
+};
+
+// One problem found by Map::validateAll(). IDs are territory/continent IDs
+// (not slots); -1 when a field doesn't apply to that kind.
+struct ValidationIssue {
+    enum Kind {
+        EmptyMap,                // no territories or no continents
+        NoContinent,             // territory is in no continent's member list
+        MultipleContinents,      // territory is in 2+ continents
+        EmptyContinent,
+        DisconnectedMap,         // see ValidationReport::mapComponents
+        DisconnectedContinent,   // see ValidationReport::continentComponents
+        AsymmetricBorder         // territoryId -> otherId but not back (warning)
+    };
+    Kind kind;
+    int territoryId;
+    int otherId;
+    int continentId;
+    int count;                   // continents / components, depending on kind
+    std::string message;
+
+    bool isError() const { return kind != AsymmetricBorder; }
+};
+
+// Everything wrong with a map, collected in one pass.
+// Components are lists of territory IDs, largest first; they are only filled
+// in for a graph that is actually split.
+struct ValidationReport {
+    std::vector<ValidationIssue> issues;
+    std::vector<std::vector<int>> mapComponents;
+    // continentId -> its components (only for disconnected continents)
+    std::vector<std::pair<int, std::vector<std::vector<int>>>> continentComponents;
+    int errorCount = 0;
+    int warningCount = 0;
+
+    bool passed() const { return errorCount == 0; }
+    void print(std::ostream& out) const;
+};
+
 // The Map owns all Continent* and Territory* objects. It is responsible for
 // deleting them when destroyed (so we avoid leaks).
 // It must also validate itself according to the assignment rules.
 
 class Map {
+    friend class MapLoader;   // bulk-builds maps from the binary format
+
 private:
     std::vector<Territory*>* territories;
     std::vector<Continent*>* continents;
+    TerritoryStore* store;   // SoA data for every territory this map owns
+
+    // ID-keyed indexes so add/find are O(1) instead of a scan per insert.
+    // The non-const getTerritories()/getContinents() hand out the vectors
+    // themselves, so they mark the indexes stale (as does anything that
+    // fills the vectors directly) and the next add/find rebuilds them.
+    // Territory::setId bumps the store ID version, which does the same.
+    std::unordered_map<int, Territory*>* territoryIndex;
+    std::unordered_map<int, Continent*>* continentIndex;
+    bool indexesStale = true;
+    unsigned indexedIdsAt = 0;
+    void syncIndexes();
+
+    void attach(Territory* t);   // bind t's data into this map's store
+    void releaseAll();           // delete owned territories/continents
+    void copyFrom(const Map& other);
+    void buildFrom(const MapTopology& topo, const MapState& state);
+
+    // Set when this map was built from a topology, and dropped by any change
+    // to its territories, continents or borders (topologyAt is the store's
+    // version when it was taken)
+    std::shared_ptr<const MapTopology> sharedTopology;
+    unsigned topologyAt = 0;
 
 public:
     Map();
     Map(const Map& other);
     Map(std::vector<Territory*>* t, std::vector<Continent*>* c);
+    Map(std::shared_ptr<const MapTopology> topology, const MapState& state);
     Map& operator=(const Map& other);
     ~Map();
 
     // Getters/setters
-    std::vector<Territory*>* getTerritories() const;
-    std::vector<Continent*>* getContinents() const;
+    // Getters for editing the vectors mark the ID indexes stale; read
+    // through a const Map to keep them (and to share one between threads)
+    std::vector<Territory*>* getTerritories();
+    std::vector<Continent*>* getContinents();
+    const std::vector<Territory*>* getTerritories() const;
+    const std::vector<Continent*>* getContinents() const;
+    TerritoryStore* getStore() const;
     void setTerritories(std::vector<Territory*>* t);
     void setContinents(std::vector<Continent*>* c);
 
@@ -140,9 +673,36 @@ public:
     void removeTerritory(Territory* t);
     void addContinent(Continent* c);
     void removeContinent(Continent* c);
+    Territory* findTerritory(int id);   // nullptr if no territory has this ID
+    Continent* findContinent(int id);
+
+    // CSR adjacency (built by MapLoader::loadMap; rebuild after editing borders)
+    void buildAdjacencyIndex();
+    bool hasAdjacencyIndex() const;
+    NeighborRange neighbors(int idx) const;   // idx = Territory::getIndex()
+
+    // Who owns what, who can attack what and who holds which continents (see
+    // OwnershipIndex). Built on first use; ownerIndex() and continentIndexOf()
+    // turn names into its keys.
+    const OwnershipIndex& getOwnership();
+    int ownerIndex(const std::string& owner) const;   // -1 if nobody by that name ever owned anything
+    int continentIndexOf(const std::string& continent) const;   // -1 if no territory was ever in it
+
+    // Topology / state split (see MapTopology). topology() hands back the
+    // shared one this map was built from, or takes a fresh snapshot.
+    std::shared_ptr<const MapTopology> topology() const;
+    MapState saveState() const;
+    bool loadState(const MapState& state);   // false if it's for a different number of territories;
+                                             // empties an attached StateJournal
 
     // Validation
     bool validate() const;
+    // Same rules and same messages, but membership is checked in one pass and
+    // continent connectivity runs on a thread pool
+    bool validate(const ValidationOptions& options) const;
+    // Don't stop at the first failure: report every violation (plus
+    // asymmetric borders as warnings). Logs the report if options.log.
+    ValidationReport validateAll(const ValidationOptions& options = ValidationOptions()) const;
 
     // Debug printing
     void printMapInfo() const;
@@ -155,9 +715,35 @@ public:
 // Reads a file into a Map object.
 // Owns its Map* and provides deep copy control.
 
+// Knobs for the memory-mapped loader path
+struct MapLoadOptions {
+    bool quiet = false;      // skip per-line "Added ..." logging
+    bool validate = true;    // run Map::validate() after loading
+    bool trusted = false;    // binary maps: skip validation if the file says it passed
+    bool silent = false;     // quiet + no error printing either (see MapLoadStats::error)
+};
+
+// Filled in by every loadMap(filename, options) call
+struct MapLoadStats {
+    std::size_t bytes = 0;
+    int lines = 0;
+    int territories = 0;
+    int borders = 0;          // directed border entries
+    double seconds = 0.0;     // parse + build (validation excluded)
+    std::string error;        // why the last load failed ("" if it didn't)
+
+    double megabytesPerSecond() const {
+        return seconds > 0.0 ? (double)bytes / (1024.0 * 1024.0) / seconds : 0.0;
+    }
+};
+
 class MapLoader {
 private:
     Map* map;
+    MapLoadStats stats;
+    bool validated;   // last load ended with a passing Map::validate()
+
+    bool runValidation(const MapLoadOptions& options);
 
 public:
     MapLoader();
@@ -167,6 +753,15 @@ public:
 
     Map* getMap() const;
     bool loadMap(const std::string& filename);
+    // Memory-mapped path: tokenizes the file in place, reports MB/s
+    bool loadMap(const std::string& filename, const MapLoadOptions& options);
+    const MapLoadStats& getLastLoadStats() const;
+
+    // Versioned binary format (see Map.cpp): save the current map, load it back
+    // with no text parsing and no duplicate checks. saveBinary validates the
+    // map it writes, so the file's validated flag is always its own.
+    bool saveBinary(const std::string& filename) const;
+    bool loadBinary(const std::string& filename, const MapLoadOptions& options);
 };
 
 #endif // MAP_H
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include "Map.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <glob.h>
+#include <sys/stat.h>
+
+// Batch map checker for the content pipeline.
+//   ./Warzone_maplint [-j N] <dir | glob | file>...
+// Directories are scanned (not recursively) for *.map and *.wzb files, globs
+// are expanded, plain files are taken as-is. Every map is loaded quietly and
+// run through Map::validateAll() on a pool of N workers (default: one per
+// core), one map per task.
+//
+// Output is JSON Lines on stdout, one object per map in sorted path order,
+// then one summary object:
+//   {"file":"a.map","ok":true,"load_ms":1.2,"validate_ms":0.3,"territories":42,
+//    "continents":6,"borders":160,"errors":0,"warnings":0,"reason":""}
+//   {"summary":true,"maps":1,"passed":1,"failed":0,"wall_ms":2.1,"threads":8}
+// Exit code: 0 if every map passed, 1 if any failed, 2 on bad arguments.
+
+namespace {
+    struct LintResult {
+        std::string file;
+        bool ok = false;
+        double loadMs = 0.0;
+        double validateMs = 0.0;
+        int territories = 0;
+        int continents = 0;
+        int borders = 0;          // directed border entries, as in MapLoadStats
+        int errors = 0;
+        int warnings = 0;
+        std::string reason;       // load error or first validation error
+    };
+
+    double msSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    bool endsWith(const std::string& s, const char* suffix) {
+        std::size_t n = std::strlen(suffix);
+        return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+    }
+
+    bool isMapFile(const std::string& path) {
+        return endsWith(path, ".map") || endsWith(path, ".wzb");
+    }
+
+    bool isDirectory(const std::string& path) {
+        struct stat st;
+        return stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+    }
+
+    // Expand one command-line argument into map paths
+    void collect(const std::string& arg, std::vector<std::string>& out) {
+        if (isDirectory(arg)) {
+            DIR* dir = opendir(arg.c_str());
+            if (!dir) return;
+            const std::string prefix = endsWith(arg, "/") ? arg : arg + "/";
+            while (dirent* entry = readdir(dir)) {
+                std::string path = prefix + entry->d_name;
+                if (isMapFile(path) && !isDirectory(path)) out.push_back(path);
+            }
+            closedir(dir);
+            return;
+        }
+        if (arg.find_first_of("*?[") != std::string::npos) {
+            glob_t matches;
+            if (glob(arg.c_str(), 0, nullptr, &matches) == 0) {
+                for (std::size_t i = 0; i < matches.gl_pathc; i++) out.push_back(matches.gl_pathv[i]);
+            }
+            globfree(&matches);
+            return;
+        }
+        out.push_back(arg);   // plain file (a missing one is reported as a load failure)
+    }
+
+    // Load + validate one map; never prints
+    LintResult lint(const std::string& path) {
+        LintResult r;
+        r.file = path;
+
+        MapLoadOptions options;
+        options.silent = true;
+        options.validate = false;   // validateAll() below reports more than validate()
+
+        MapLoader loader;
+        auto start = std::chrono::steady_clock::now();
+        bool loaded = endsWith(path, ".wzb") ? loader.loadBinary(path, options)
+                                             : loader.loadMap(path, options);
+        r.loadMs = msSince(start);
+        const MapLoadStats& stats = loader.getLastLoadStats();
+        r.territories = stats.territories;
+        r.borders = stats.borders;
+        if (!loaded) {
+            r.errors = 1;
+            r.reason = stats.error;
+            return r;
+        }
+        const Map& map = *loader.getMap();
+        r.continents = (int)map.getContinents()->size();
+
+        ValidationOptions check;
+        check.threads = 1;   // the pool is already one map per worker
+        check.log = false;
+        start = std::chrono::steady_clock::now();
+        ValidationReport report = loader.getMap()->validateAll(check);
+        r.validateMs = msSince(start);
+
+        r.ok = report.passed();
+        r.errors = report.errorCount;
+        r.warnings = report.warningCount;
+        for (auto& issue : report.issues) {
+            if (!issue.isError()) continue;
+            r.reason = issue.message;
+            r.reason.erase(0, r.reason.find_first_not_of(' '));
+            break;
+        }
+        return r;
+    }
+
+    std::string jsonString(const std::string& s) {
+        std::string out = "\"";
+        for (char ch : s) {
+            unsigned char c = (unsigned char)ch;
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += ch;
+            } else if (c < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                out += buf;
+            } else {
+                out += ch;
+            }
+        }
+        return out + "\"";
+    }
+
+    std::string toJson(const LintResult& r) {
+        std::ostringstream o;
+        o << "{\"file\":" << jsonString(r.file)
+          << ",\"ok\":" << (r.ok ? "true" : "false")
+          << ",\"load_ms\":" << r.loadMs
+          << ",\"validate_ms\":" << r.validateMs
+          << ",\"territories\":" << r.territories
+          << ",\"continents\":" << r.continents
+          << ",\"borders\":" << r.borders
+          << ",\"errors\":" << r.errors
+          << ",\"warnings\":" << r.warnings
+          << ",\"reason\":" << jsonString(r.reason) << "}";
+        return o.str();
+    }
+
+    int usage() {
+        std::cerr << "Usage: Warzone_maplint [-j N] <dir | glob | file>...\n";
+        return 2;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) return usage();
+    int threads = 0;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-j") {
+            if (++i >= argc) return usage();
+            threads = std::atoi(argv[i]);
+            if (threads <= 0) return usage();
+        } else if (arg == "-h" || arg == "--help") {
+            return usage();
+        } else {
+            collect(arg, paths);
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+
+    auto start = std::chrono::steady_clock::now();
+    ThreadPool pool(threads);
+
+    // Everything is queued up front (a task is just a path); results are
+    // printed in order as they finish, so output streams on big batches.
+    std::vector<std::future<LintResult>> results;
+    results.reserve(paths.size());
+    for (const auto& path : paths) {
+        results.push_back(pool.submit([path]() { return lint(path); }));
+    }
+
+    int passed = 0;
+    for (auto& f : results) {
+        LintResult r = f.get();
+        if (r.ok) passed++;
+        std::cout << toJson(r) << "\n";
+    }
+
+    const int failed = (int)paths.size() - passed;
+    std::cout << "{\"summary\":true,\"maps\":" << paths.size()
+              << ",\"passed\":" << passed
+              << ",\"failed\":" << failed
+              << ",\"wall_ms\":" << msSince(start)
+              << ",\"threads\":" << pool.size() << "}\n";
+    return failed == 0 ? 0 : 1;
+}
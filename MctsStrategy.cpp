@@ -0,0 +1,307 @@
+#include "MctsStrategy.h"
+#include "GameEngine.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+namespace {
+    // splitmix64: neighbouring rollout numbers get unrelated seeds
+    std::uint64_t mix(std::uint64_t z) {
+        z += 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Next plan to try: any plan not tried yet, else the best UCB1 bound.
+    // Visits count rollouts still running (scored 0 until they finish), so
+    // a plan being tried elsewhere looks a little worse: the virtual loss.
+    int select(const std::vector<double>& total, const std::vector<long long>& visits, double c) {
+        long long all = 0;
+        for (std::size_t a = 0; a < visits.size(); a++) {
+            if (visits[a] == 0) return (int)a;
+            all += visits[a];
+        }
+        const double logAll = std::log((double)all);
+        int best = 0;
+        double bestBound = -1.0;
+        for (std::size_t a = 0; a < visits.size(); a++) {
+            const double bound = total[a] / visits[a] + c * std::sqrt(logAll / visits[a]);
+            if (bound > bestBound) {
+                bestBound = bound;
+                best = (int)a;
+            }
+        }
+        return best;
+    }
+}
+
+// ================= Construction =================
+
+MctsStrategy::MctsStrategy(const MctsConfig& c)
+    : config(c), turns(0), pool(nullptr), boardsFor(nullptr), boardsAt(0) {}
+
+MctsStrategy::MctsStrategy(const MctsStrategy& other)
+    : config(other.config), turns(0), pool(nullptr), boardsFor(nullptr), boardsAt(0) {}
+
+MctsStrategy& MctsStrategy::operator=(const MctsStrategy& other) {
+    if (this != &other) {
+        releaseWorkers();
+        config = other.config;
+        report = MctsReport();
+        turns = 0;
+    }
+    return *this;
+}
+
+MctsStrategy::~MctsStrategy() {
+    releaseWorkers();
+}
+
+PlayerStrategy* MctsStrategy::clone() const {
+    return new MctsStrategy(*this);
+}
+
+// Pool first (no rollout may still be running), then each engine before the
+// board it plays on
+void MctsStrategy::releaseWorkers() {
+    delete pool;
+    pool = nullptr;
+    for (auto& w : workers) {
+        delete w.engine;
+        delete w.board;
+    }
+    workers.clear();
+    boardsFor = nullptr;
+    names.clear();
+}
+
+// Boards are kept while the game is the same one: same map, same territories
+void MctsStrategy::prepare(const Map& map, const std::vector<std::string>& players) {
+    const unsigned version = map.getStore()->getTopologyVersion();
+    if (!workers.empty() && boardsFor == &map && boardsAt == version && names == players
+        && static_cast<const Map*>(workers[0].board)->getTerritories()->size() == map.getTerritories()->size()) {
+        return;
+    }
+    releaseWorkers();
+
+    std::shared_ptr<const MapTopology> topology = map.topology();
+    const MapState position = map.saveState();
+    const int threads = config.threads > 0 ? config.threads : ThreadPool::defaultThreadCount();
+    for (int k = 0; k < threads; k++) {
+        Worker w;
+        w.board = new Map(topology, position);
+        w.engine = new GameEngine();
+        w.engine->attach(*w.board, players);
+        w.root = 0;
+        workers.push_back(w);
+    }
+    // the calling thread is worker 0
+    if (threads > 1) pool = new ThreadPool(threads - 1);
+    boardsFor = &map;
+    boardsAt = version;
+    names = players;
+}
+
+// The root's children, from worker 0's board (at the turn's position). Slots
+// are board slots, i.e. positions in the map's territory list.
+std::vector<std::vector<OrderRecord>> MctsStrategy::plans(int me) {
+    GameEngine& engine = *workers[0].engine;
+    Map& board = *workers[0].board;
+    Player* self = engine.playerById(me);
+    std::vector<std::vector<OrderRecord>> out;
+
+    // plan 0: what the built-in policy would play
+    std::mt19937_64 rng(mix(config.seed ^ turns));
+    engine.issuePolicyOrders(self, rng);
+    OrdersList* list = self->getOrder();
+    std::vector<OrderRecord> policy;
+    for (int i = 0; i < list->size(); i++) policy.push_back(list->recordAt(i));
+    list->clear();
+    out.push_back(policy);
+
+    TerritoryStore* store = board.getStore();
+    const OwnershipIndex& index = board.getOwnership();
+    const std::vector<int>& owners = store->getOwners();
+    const std::vector<int>& armies = store->getArmies();
+    const int owner = store->ownerOf(me);
+    const int reinforcements = engine.reinforcementFor(self);
+
+    // attacks that need no reinforcement: every border against its weakest neighbor
+    std::vector<OrderRecord> spare;
+    for (auto* t : index.owned(owner)) {
+        const int slot = t->getIndex();
+        int weakest = -1;
+        for (int nb : store->neighbors(slot)) {
+            if (owners[nb] != owner && (weakest < 0 || armies[nb] < armies[weakest])) weakest = nb;
+        }
+        if (weakest >= 0 && armies[slot] - 1 > armies[weakest]) {
+            spare.push_back(OrderRecord{OrderKind::Advance, me, weakest, slot, armies[slot] - 1});
+        }
+    }
+
+    // one all-in strike per reachable enemy territory, from our strongest
+    // territory next to it; best margins first
+    struct Strike {
+        int margin;
+        int border;
+        int target;
+    };
+    std::vector<Strike> strikes;
+    for (auto* t : index.frontier(owner)) {
+        const int target = t->getIndex();
+        int border = -1;
+        for (int nb : store->neighbors(target)) {
+            if (owners[nb] == owner && (border < 0 || armies[nb] > armies[border])) border = nb;
+        }
+        if (border < 0) continue;
+        const int margin = armies[border] + reinforcements - 1 - armies[target];
+        if (margin > 0) strikes.push_back(Strike{margin, border, target});
+    }
+    std::sort(strikes.begin(), strikes.end(), [](const Strike& a, const Strike& b) {
+        return a.margin != b.margin ? a.margin > b.margin : a.target < b.target;
+    });
+    if ((int)strikes.size() > config.maxPlans) strikes.resize(std::max(0, config.maxPlans));
+
+    for (const Strike& s : strikes) {
+        std::vector<OrderRecord> plan;
+        plan.push_back(OrderRecord{OrderKind::Deploy, me, s.border, -1, reinforcements});
+        plan.push_back(OrderRecord{OrderKind::Advance, me, s.target, s.border,
+                                   armies[s.border] + reinforcements - 1});
+        for (const OrderRecord& r : spare) {
+            if (r.source != s.border && r.target != s.target) plan.push_back(r);
+        }
+        out.push_back(plan);
+    }
+    return out;
+}
+
+// Board slots back to the real map's territories
+void MctsStrategy::issue(Player& player, const std::vector<OrderRecord>& plan) const {
+    const Map& map = *player.getMap();
+    const std::vector<Territory*>& territories = *map.getTerritories();
+    OrdersList* list = player.getOrder();
+    const bool records = list->storage() == OrdersStorage::Records;
+    for (const OrderRecord& r : plan) {
+        Territory* target = territories[r.target];
+        Territory* source = r.source >= 0 ? territories[r.source] : nullptr;
+        if (records) {
+            list->addRecord(OrderRecord{r.kind, player.getId(), target->getIndex(),
+                                        source != nullptr ? source->getIndex() : -1, r.armies});
+        } else if (r.kind == OrderKind::Deploy) {
+            list->add(new Deploy(&player, target, r.armies));
+        } else {
+            list->add(new Advance(&player, target, source, r.armies));
+        }
+    }
+}
+
+// ================= The search =================
+
+void MctsStrategy::issueOrder(Player& player) {
+    report = MctsReport();
+    Map* map = player.getMap();
+    const int me = player.getId();
+    TerritoryStore* store = map != nullptr ? map->getStore() : nullptr;
+    if (store == nullptr || store->ownerOf(me) < 0) {
+        // not in a game with bound players: the plain default
+        std::vector<Territory*> owned = player.getTerritory();
+        if (!owned.empty()) player.getOrder()->add(new Deploy(&player, owned.front(), 1));
+        return;
+    }
+    if (map->getOwnership().owned(store->ownerOf(me)).empty()) return;
+
+    // the game's players by id. GameEngine binds Neutral last, at the id
+    // one past the real players, so that one is left out (the boards'
+    // engines add their own).
+    const int neutral = store->playerCount() - 1;
+    if (me >= neutral) return;
+    std::vector<std::string> players;
+    for (int id = 0; id < neutral; id++) {
+        const int owner = store->ownerOf(id);
+        players.push_back(owner >= 0 ? store->ownerName(owner) : "");
+    }
+    prepare(*map, players);
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + std::chrono::milliseconds(config.budgetMs);
+    turns++;
+
+    // every worker starts from this position; rollouts are undone back to it
+    const MapState position = map->saveState();
+    for (auto& w : workers) {
+        w.engine->resetTo(position);
+        w.root = w.engine->checkpoint();
+    }
+    const std::vector<std::vector<OrderRecord>> candidates = plans(me);
+
+    std::vector<double> total(candidates.size(), 0.0);
+    std::vector<long long> visits(candidates.size(), 0);
+    std::mutex statsLock;
+    std::atomic<long long> rollouts(0);
+    const std::uint64_t base = mix(config.seed + (turns << 32));
+
+    auto search = [&](int k) {
+        Worker& w = workers[k];
+        Player* self = w.engine->playerById(me);
+        do {
+            int arm;
+            {
+                std::lock_guard<std::mutex> guard(statsLock);
+                arm = select(total, visits, config.exploration);
+                visits[arm]++;
+            }
+            w.engine->rollback(w.root);
+            for (const OrderRecord& r : candidates[arm]) self->getOrder()->addRecord(r);
+            const long long n = rollouts++;
+            SimulationResult r = w.engine->playFrom(mix(base + (std::uint64_t)n), config.horizon + 1, me);
+
+            double score;
+            if (r.winner >= 0) {
+                score = r.winner == me ? 1.0 : 0.0;
+            } else {
+                int held = 0;
+                for (int c : r.territories) held += c;
+                score = held > 0 ? (double)r.territories[me] / held : 0.0;
+            }
+            std::lock_guard<std::mutex> guard(statsLock);
+            total[arm] += score;
+        } while (std::chrono::steady_clock::now() < deadline);
+    };
+
+    std::vector<std::future<void>> helpers;
+    for (int k = 1; k < (int)workers.size(); k++) {
+        helpers.push_back(pool->submit([&search, k] { search(k); }));
+    }
+    search(0);
+    for (auto& h : helpers) h.get();
+
+    // most visited plan (ties: best mean)
+    int chosen = 0;
+    for (int a = 1; a < (int)candidates.size(); a++) {
+        if (visits[a] > visits[chosen]
+            || (visits[a] == visits[chosen] && total[a] > total[chosen])) chosen = a;
+    }
+    issue(player, candidates[chosen]);
+
+    report.rollouts = rollouts.load();
+    report.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    report.rolloutsPerSecond = report.ms > 0.0 ? report.rollouts * 1000.0 / report.ms : 0.0;
+    report.plans = (int)candidates.size();
+    report.chosen = chosen;
+    report.value = visits[chosen] > 0 ? total[chosen] / visits[chosen] : 0.0;
+    report.threads = (int)workers.size();
+    if (config.verbose) {
+        std::cout << "[mcts] " << player.getPName() << ": " << report.rollouts << " rollouts in "
+                  << report.ms << " ms (" << report.rolloutsPerSecond << "/s, " << report.threads
+                  << " threads), " << report.plans << " plans, played " << chosen
+                  << " (" << report.value << ")\n";
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef MCTSSTRATEGY_H
+#define MCTSSTRATEGY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Map.h"
+#include "Orders.h"
+#include "Player.h"
+
+class GameEngine;
+class ThreadPool;
+
+// ============================================================================
+// MctsStrategy
+// ============================================================================
+// Search player: picks its turn by Monte Carlo tree search over rollouts of
+// the real game. Each turn:
+//  - candidate plans are built from the current position: the built-in
+//    policy's orders, and one all-in plan per enemy territory it can reach
+//    (every reinforcement on the best border next to it, attack it, plus
+//    every other border attack that already outnumbers its target)
+//  - the plans are the children of the root; UCB1 picks the next one to
+//    try, with a virtual loss so parallel workers spread out
+//  - a rollout plays the plan (everyone else uses the built-in policy),
+//    then `horizon` more policy turns, and scores 1 for a win, 0 for a
+//    loss, otherwise our share of the players' territories
+//  - when the time budget is spent, the most visited plan is played
+// Simultaneous turns make deeper levels of the tree a poor fit (the other
+// players' replies aren't a choice the tree could branch on), so the tree
+// is one level and the rollouts stand in for the rest of the game.
+//
+// Rollouts run on `threads` workers. Each one keeps its own board (built
+// from the map's shared MapTopology) and a headless GameEngine across
+// turns: a turn loads the position once, and every rollout is undone
+// through the engine's journal, so a rollout costs what it plays.
+// Plugs into Player::issueOrder:
+//   player->setStrategy(new MctsStrategy(config));
+// The player's map must have its players bound (a GameEngine game).
+
+struct MctsConfig {
+    int budgetMs = 50;          // search time per turn (the first turn also builds the boards)
+    int threads = 0;            // rollout workers (<= 0: one per hardware thread)
+    int horizon = 6;            // policy turns played after the plan's turn
+    int maxPlans = 12;          // all-in plans per turn (plus the policy's)
+    double exploration = 0.5;   // UCB1 constant
+    std::uint64_t seed = 1;
+    bool verbose = false;       // one line per turn on stdout
+};
+
+// What the last turn's search did
+struct MctsReport {
+    long long rollouts = 0;
+    double ms = 0.0;
+    double rolloutsPerSecond = 0.0;
+    int plans = 0;
+    int chosen = -1;            // plan played (0: the built-in policy's)
+    double value = 0.0;         // its mean score
+    int threads = 0;
+};
+
+class MctsStrategy : public PlayerStrategy {
+private:
+    // One rollout worker: a board on the map's topology and an engine on it
+    struct Worker {
+        Map* board;
+        GameEngine* engine;
+        StateJournal::Mark root;   // the turn's position, as a journal mark
+    };
+
+    MctsConfig config;
+    MctsReport report;
+    std::uint64_t turns;                   // searches so far (seeds the next one)
+    ThreadPool* pool;                      // nullptr until the first search
+    std::vector<Worker> workers;
+    const Map* boardsFor;                  // the map (and its store version) the boards copy
+    unsigned boardsAt;
+    std::vector<std::string> names;        // the game's players, by id
+
+    void prepare(const Map& map, const std::vector<std::string>& players);
+    void releaseWorkers();
+    std::vector<std::vector<OrderRecord>> plans(int me);
+    void issue(Player& player, const std::vector<OrderRecord>& plan) const;
+
+public:
+    explicit MctsStrategy(const MctsConfig& config = MctsConfig());
+    MctsStrategy(const MctsStrategy& other);   // same config; boards are built on first use
+    MctsStrategy& operator=(const MctsStrategy& other);
+    ~MctsStrategy();
+
+    void issueOrder(Player& player);
+    PlayerStrategy* clone() const;
+
+    const MctsReport& lastSearch() const { return report; }
+    const MctsConfig& getConfig() const { return config; }
+};
+
+#endif // MCTSSTRATEGY_H
@@ -0,0 +1,103 @@
+#include "OrderScheduler.h"
+
+OrderScheduler::OrderScheduler(int players) : players(0), live(0) {
+    reset(players);
+}
+
+void OrderScheduler::reset(int p) {
+    players = p < 0 ? 0 : p;
+    live = 0;
+    nodes.clear();
+    head.assign(players * LEVELS, -1);
+    tail.assign(players * LEVELS, -1);
+}
+
+OrderScheduler::Handle OrderScheduler::add(int player, int priority, int index) {
+    if (player < 0 || player >= players) return -1;
+    if (priority < 0 || priority >= LEVELS) priority = OTHER;
+    Node node;
+    node.item.player = player;
+    node.item.index = index;
+    node.prev = -1;
+    node.next = -1;
+    node.queue = -1;
+    nodes.push_back(node);
+    const int n = (int)nodes.size() - 1;
+    linkBefore(n, queueOf(player, priority), -1);
+    live++;
+    return n;
+}
+
+bool OrderScheduler::contains(Handle h) const {
+    return h >= 0 && h < (int)nodes.size() && nodes[h].queue >= 0;
+}
+
+bool OrderScheduler::remove(Handle h) {
+    if (!contains(h)) return false;
+    unlink(h);
+    nodes[h].queue = -1;
+    live--;
+    return true;
+}
+
+bool OrderScheduler::moveBefore(Handle h, Handle before) {
+    if (!contains(h) || !contains(before)) return false;
+    const int queue = nodes[h].queue;
+    if (nodes[before].queue != queue) return false;
+    if (h == before) return true;
+    unlink(h);
+    linkBefore(h, queue, before);
+    return true;
+}
+
+bool OrderScheduler::moveToBack(Handle h) {
+    if (!contains(h)) return false;
+    const int queue = nodes[h].queue;
+    unlink(h);
+    linkBefore(h, queue, -1);
+    return true;
+}
+
+void OrderScheduler::unlink(int n) {
+    Node& node = nodes[n];
+    if (node.prev >= 0) nodes[node.prev].next = node.next;
+    else head[node.queue] = node.next;
+    if (node.next >= 0) nodes[node.next].prev = node.prev;
+    else tail[node.queue] = node.prev;
+    node.prev = -1;
+    node.next = -1;
+}
+
+void OrderScheduler::linkBefore(int n, int queue, int before) {
+    Node& node = nodes[n];
+    node.queue = queue;
+    node.next = before;
+    node.prev = before >= 0 ? nodes[before].prev : tail[queue];
+    if (node.prev >= 0) nodes[node.prev].next = n;
+    else head[queue] = n;
+    if (before >= 0) nodes[before].prev = n;
+    else tail[queue] = n;
+}
+
+void OrderScheduler::merge(std::vector<ScheduledOrder>& out) const {
+    out.clear();
+    out.reserve(live);
+    for (int level = 0; level < LEVELS; level++) {
+        // cursor holds the current node of every player with orders left at
+        // this level; players drop out (in place) as their queue runs dry
+        cursor.clear();
+        for (int p = 0; p < players; p++) {
+            const int first = head[queueOf(p, level)];
+            if (first >= 0) cursor.push_back(first);
+        }
+        while (!cursor.empty()) {
+            int kept = 0;
+            for (int c = 0; c < (int)cursor.size(); c++) {
+                const Node& node = nodes[cursor[c]];
+                out.push_back(node.item);
+                if (node.next >= 0) cursor[kept++] = node.next;
+            }
+            cursor.resize(kept);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef ORDERSCHEDULER_H
+#define ORDERSCHEDULER_H
+
+#include <vector>
+
+// ============================================================================
+// Order scheduler
+// ============================================================================
+// Decides the execution order of a round. Warzone runs every Deploy first,
+// then Airlifts, then Blockades, then everything else; inside one priority
+// level players take turns (first order of each player, then the second...).
+//
+// Entries are (player, index in that player's OrdersList), so the scheduler
+// works with either storage mode and never owns an order. Every
+// (priority, player) pair has its own intrusive doubly-linked queue, with
+// links stored in one node pool:
+//  - add() appends in O(1) and returns a handle (the node's slot)
+//  - remove(), moveBefore() and moveToBack() are O(1) by handle
+//  - merge() writes the whole round's order in a single pass
+// Handles stay valid until reset(). reset() keeps the pool's capacity, so a
+// scheduler reused every round stops allocating once it has seen the largest
+// round.
+
+struct ScheduledOrder {
+    int player;   // index in the game's player list
+    int index;    // position in that player's OrdersList
+};
+
+class OrderScheduler {
+public:
+    typedef int Handle;
+
+    // priority levels, in execution order
+    static const int DEPLOY = 0;
+    static const int AIRLIFT = 1;
+    static const int BLOCKADE = 2;
+    static const int OTHER = 3;
+    static const int LEVELS = 4;
+
+    explicit OrderScheduler(int players = 0);
+
+    // drop every entry and size the queues for `players` players
+    void reset(int players);
+
+    Handle add(int player, int priority, int index);
+
+    // false for a stale handle (already removed, or from before reset())
+    bool remove(Handle h);
+    // h goes right before `before`; both must be in the same queue
+    // (same player and priority), since priority comes from the order kind
+    bool moveBefore(Handle h, Handle before);
+    bool moveToBack(Handle h);
+
+    bool contains(Handle h) const;
+    const ScheduledOrder& get(Handle h) const { return nodes[h].item; }
+    int size() const { return live; }
+    int playerCount() const { return players; }
+
+    // Execution order of everything still queued: level by level, and
+    // round-robin across players inside a level. Replaces out's contents.
+    void merge(std::vector<ScheduledOrder>& out) const;
+
+private:
+    struct Node {
+        ScheduledOrder item;
+        int prev;
+        int next;
+        int queue;   // -1 once removed
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> head;   // per queue (priority * players + player), -1 if empty
+    std::vector<int> tail;
+    int players;
+    int live;
+    mutable std::vector<int> cursor;   // merge() scratch, kept to avoid reallocating
+
+    int queueOf(int player, int priority) const { return priority * players + player; }
+    void unlink(int n);
+    void linkBefore(int n, int queue, int before);   // before == -1 appends
+};
+
+#endif // ORDERSCHEDULER_H
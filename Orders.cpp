@@ -1,11 +1,257 @@
 #include "Orders.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <future>
 #include <iostream>
 
+// ================= TruceTable =================
+
+TruceTable::TruceTable() : players(0), words(0) {}
+
+void TruceTable::reset(int p) {
+    if (p < 0) p = 0;
+    if (p == players) {
+        clear();
+        return;
+    }
+    players = p;
+    words = (p + 63) / 64;
+    bits.assign((std::size_t)players * words, 0);
+    dirty.clear();
+    rowDirty.assign(players, 0);
+}
+
+void TruceTable::clear() {
+    for (int row : dirty) {
+        std::fill(bits.begin() + (std::size_t)row * words, bits.begin() + (std::size_t)(row + 1) * words, 0);
+        rowDirty[row] = 0;
+    }
+    dirty.clear();
+}
+
+void TruceTable::markDirty(int row) {
+    if (rowDirty[row]) return;
+    rowDirty[row] = 1;
+    dirty.push_back(row);
+}
+
+void TruceTable::add(int a, int b) {
+    if (a < 0 || b < 0) return;
+    if (std::max(a, b) >= players) {
+        // rare (ids past the size given to reset): rebuild bigger, keep what's set
+        TruceTable bigger;
+        bigger.reset(std::max(a, b) + 1);
+        for (int row : dirty) {
+            for (int col = 0; col < players; col++) {
+                if (atTruce(row, col)) bigger.add(row, col);
+            }
+        }
+        *this = bigger;
+    }
+    bits[(std::size_t)a * words + (b >> 6)] |= 1ULL << (b & 63);
+    bits[(std::size_t)b * words + (a >> 6)] |= 1ULL << (a & 63);
+    markDirty(a);
+    markDirty(b);
+}
+
+// ================= ExecutionContext =================
+
+void ExecutionContext::beginRound() {
+    truces.reset(players != nullptr ? (int)players->size() : 0);
+    executed = 0;
+    rejected = 0;
+}
+
+bool ExecutionContext::atTruce(const Player* a, const Player* b) const {
+    if (a == nullptr || b == nullptr) return false;
+    return truces.atTruce(a->getId(), b->getId());
+}
+
+Player* ExecutionContext::ownerOf(const Territory* t) const {
+    // in a game the store knows player ids: one lookup, no names
+    if (t->getStore()->hasPlayers()) {
+        const int id = t->getOwnerId();
+        if (id < 0) return nullptr;
+        if (players != nullptr && id < (int)players->size()) return (*players)[id];
+        if (neutral != nullptr && id == neutral->getId()) return neutral;
+        return nullptr;
+    }
+    if (players != nullptr) {
+        for (auto* p : *players) {
+            if (t->isOwnedBy(p->getPName())) return p;
+        }
+    }
+    if (neutral != nullptr && t->isOwnedBy(neutral->getPName())) return neutral;
+    return nullptr;
+}
+
+void ExecutionContext::transfer(Territory* t, Player* to) {
+    Player* from = ownerOf(t);
+    if (from == to && from != nullptr) return;
+    if (from != nullptr) from->removeTerritory(t);
+    if (to != nullptr && t->getStore()->ownerOf(to->getId()) >= 0) t->setOwnerId(to->getId());
+    else t->setOwner(to != nullptr ? to->getPName() : "Neutral");
+    if (to != nullptr) to->addTerritory(t);
+}
+
+GameSnapshot ExecutionContext::snapshot() const {
+    GameSnapshot s;
+    s.battles = battles;
+    if (map == nullptr) return s;
+    s.map = map->saveState();
+    s.topology = map->getStore()->getTopologyVersion();
+    auto holdingsOf = [](const Player* p) {
+        std::vector<int> slots;
+        for (auto* t : p->getTerritory()) slots.push_back(t->getIndex());
+        return slots;
+    };
+    if (players != nullptr) {
+        for (auto* p : *players) s.holdings.push_back(holdingsOf(p));
+    }
+    if (neutral != nullptr) s.holdings.push_back(holdingsOf(neutral));
+    return s;
+}
+
+bool ExecutionContext::restore(const GameSnapshot& s) {
+    if (map == nullptr) return false;
+    TerritoryStore* store = map->getStore();
+    const std::size_t lists = (players != nullptr ? players->size() : 0) + (neutral != nullptr ? 1 : 0);
+    if (s.topology != store->getTopologyVersion() || s.holdings.size() != lists) return false;
+    if (!map->loadState(s.map)) return false;
+    std::vector<Territory*> owned;
+    for (std::size_t i = 0; i < lists; i++) {
+        Player* p = i < (players != nullptr ? players->size() : 0) ? (*players)[i] : neutral;
+        owned.clear();
+        for (int slot : s.holdings[i]) owned.push_back(store->handle(slot));
+        p->setTerritory(owned);
+    }
+    battles = s.battles;
+    return true;
+}
+
+void ExecutionContext::rollback(StateJournal& journal, StateJournal::Mark mark) {
+    if (map == nullptr) return;
+    TerritoryStore* store = map->getStore();
+    while (journal.size() > mark) {
+        const StateJournal::Entry e = journal.back();
+        journal.pop();
+        if (e.field != StateJournal::Owner) {
+            store->undo(e);
+            continue;
+        }
+        Territory* t = store->handle(e.slot);
+        Player* now = ownerOf(t);
+        store->undo(e);
+        Player* was = ownerOf(t);
+        if (now == was) continue;
+        if (now != nullptr) now->removeTerritory(t);
+        if (was != nullptr) was->addTerritory(t);
+    }
+}
+
+namespace {
+    // Shared by Advance and Airlift: send `moving` armies (already taken off
+    // the source) against an enemy territory. Survivors take the territory if
+    // every defender died, otherwise they go back to the source.
+    void attack(ExecutionContext& ctx, Player* attacker, Territory* source, Territory* targ, int moving) {
+        Battle battle;
+        battle.attackers = moving;
+        battle.defenders = targ->getArmies();
+        ctx.combat.resolve(battle, ctx.battles++);
+        if (battle.defendersLeft == 0 && battle.attackersLeft > 0) {
+            ctx.transfer(targ, attacker);
+            targ->setArmies(battle.attackersLeft);
+        } else {
+            targ->setArmies(battle.defendersLeft);
+            source->setArmies(source->getArmies() + battle.attackersLeft);
+        }
+    }
+
+    int idOf(const Player* p) { return p ? p->getId() : -1; }
+    int slotOf(const Territory* t) { return t ? t->getIndex() : -1; }
+
+    // Player ids when the territory's store has the players bound (a game),
+    // owner names otherwise (drivers, loose territories)
+    bool owns(const Player* p, const Territory* t) {
+        if (t->getStore()->hasPlayers()) return p->getId() >= 0 && t->getOwnerId() == p->getId();
+        return t->isOwnedBy(p->getPName());
+    }
+
+    // ---- Game rules: shared by the order classes and the record path ----
+    // can*() only read the game, apply*() assume can*() passed.
+
+    bool canDeploy(const Player* p, const Territory* targ) {
+        return owns(p, targ);
+    }
+
+    void applyDeploy(Territory* targ, int armies) {
+        targ->setArmies(targ->getArmies() + armies);
+    }
+
+    bool canAdvance(const ExecutionContext& ctx, const Player* p, const Territory* source, const Territory* targ) {
+        if (source == targ || !owns(p, source)) return false;
+        if (!source->isAdjacent(*targ)) return false;
+        if (owns(p, targ)) return true;
+        return !ctx.atTruce(p, ctx.ownerOf(targ));
+    }
+
+    bool canAirlift(const ExecutionContext& ctx, const Player* p, const Territory* source, const Territory* targ) {
+        if (source == targ || !owns(p, source)) return false;
+        if (owns(p, targ)) return true;
+        return !ctx.atTruce(p, ctx.ownerOf(targ));
+    }
+
+    // Advance/Airlift: can't send more than what's there (earlier orders
+    // may have moved some). Moves into an own territory, attacks otherwise.
+    bool applyMove(ExecutionContext& ctx, Player* p, Territory* source, Territory* targ, int armies) {
+        const int moving = std::min(armies, source->getArmies());
+        if (moving <= 0) return false;
+        source->setArmies(source->getArmies() - moving);
+        if (owns(p, targ)) {
+            targ->setArmies(targ->getArmies() + moving);
+        } else {
+            attack(ctx, p, source, targ, moving);
+        }
+        return true;
+    }
+
+    bool canBomb(const ExecutionContext& ctx, const Player* p, const Territory* targ) {
+        if (owns(p, targ)) return false;
+        if (ctx.atTruce(p, ctx.ownerOf(targ))) return false;
+        for (auto nb : *targ->getAdjacentTerritories()) {
+            if (owns(p, nb)) return true;
+        }
+        return false;
+    }
+
+    void applyBomb(Territory* targ) {
+        targ->setArmies(targ->getArmies() / 2);
+    }
+
+    bool canBlockade(const Player* p, const Territory* targ) {
+        return owns(p, targ);
+    }
+
+    void applyBlockade(ExecutionContext& ctx, Territory* targ) {
+        targ->setArmies(targ->getArmies() * 2);
+        ctx.transfer(targ, ctx.neutral);
+    }
+
+    // both players need an id (their row/column in the truce table)
+    bool canNegotiate(const Player* p, const Player* other) {
+        return p->getId() >= 0 && other->getId() >= 0 && p->getId() != other->getId();
+    }
+
+    void applyNegotiate(ExecutionContext& ctx, const Player* p, const Player* other) {
+        ctx.truces.add(p->getId(), other->getId());
+    }
+}
+
 // ================= Orders =================
 
 // default constructor
 Orders::Orders() {
-    player = new Player();
+    player = nullptr;
 }
 
 // parameterized constructor
@@ -13,23 +259,19 @@ Orders::Orders(Player* playr) {
     this->player = playr;
 }
 
-// copy constructor
+// copy constructor (same player, not a copy of it)
 Orders::Orders(const Orders& order) {
-    player = new Player(*order.player);
+    player = order.player;
 }
 
-// destructor
+// destructor (nothing owned)
 Orders::~Orders() {
-    delete player;
 }
 
 // assignment operator
 Orders& Orders::operator=(const Orders& order) {
     if (this != &order) {
-        if (this->player != nullptr) {
-            delete player;
-        }
-        this->player = new Player(*order.player);
+        this->player = order.player;
     }
     return *this;
 }
@@ -41,12 +283,12 @@ std::ostream& operator<<(std::ostream& os, const Orders& order) {
 }
 
 // getters/setters
-Player Orders::getPlayer() const {
-    return *player;
+Player* Orders::getPlayer() const {
+    return player;
 }
 
-void Orders::setPlayer(Player playr) {
-    *player = playr;
+void Orders::setPlayer(Player* playr) {
+    player = playr;
 }
 
 
@@ -57,40 +299,31 @@ void Orders::setPlayer(Player playr) {
 // default constructor
 Deploy::Deploy() : Orders(nullptr) {
     targ = nullptr;
-    armyNum = nullptr;
+    armyNum = 0;
 }
 
 // parameterized constructor
-Deploy::Deploy(Player* playr, Territory* target, int* armynum) {
-    this->player = playr;
+Deploy::Deploy(Player* playr, Territory* target, int armynum) : Orders(playr) {
     this->targ = target;
     this->armyNum = armynum;
 }
 
 // copy constructor
-Deploy::Deploy(const Deploy& order) {
-    player = new Player(*order.player);
-    targ = new Territory(*order.targ);
-    armyNum = new int(*order.armyNum);
+Deploy::Deploy(const Deploy& order) : Orders(order) {
+    targ = order.targ;
+    armyNum = order.armyNum;
 }
 
 // destructor
 Deploy::~Deploy() {
-    delete player;
-    delete targ;
-    delete armyNum;
 }
 
 // assignment operator
 Deploy& Deploy::operator=(const Deploy& order) {
     if (this != &order) {
-        if (this->player != nullptr) delete player;
-        if (this->targ != nullptr) delete targ;
-        if (this->armyNum != nullptr) delete armyNum;
-
-        this->player = new Player(*order.player);
-        this->targ = new Territory(*order.targ);
-        this->armyNum = new int(*order.armyNum);
+        Orders::operator=(order);
+        this->targ = order.targ;
+        this->armyNum = order.armyNum;
     }
     return *this;
 }
@@ -98,47 +331,51 @@ Deploy& Deploy::operator=(const Deploy& order) {
 // stream insertion
 std::ostream& operator<<(std::ostream& os, const Deploy& order) {
     os << "This is a Deploy order belonging to " << order.player
-       << " to deploy " << *order.armyNum
+       << " to deploy " << order.armyNum
        << " armies to the territory " << order.targ;
     return os;
 }
 
 // getters/setters
-Player Deploy::getPlayer() const {
-    return *player;
+Territory* Deploy::getTarg() const {
+    return targ;
 }
 
-void Deploy::setPlayer(Player playr) {
-    *this->player = playr;
-}
-
-Territory Deploy::getTarg() const {
-    return *targ;
-}
-
-void Deploy::setTarget(Territory targ) {
-    *this->targ = targ;
+void Deploy::setTarget(Territory* targ) {
+    this->targ = targ;
 }
 
 int Deploy::getArmynum() const {
-    return *armyNum;
+    return armyNum;
 }
 
 void Deploy::setArmynum(int armies) {
-    *armyNum = armies;
+    armyNum = armies;
 }
 
 // validate
 bool Deploy::validate() const {
-    if (player == nullptr || targ == nullptr || *armyNum <= 0) return false;
+    if (player == nullptr || targ == nullptr || armyNum <= 0) return false;
     // NOTE: adjust this check depending on your Player/Territory API
     return true;
 }
 
-// execute
+// execute without a game: fresh context (combat seed 0, no truces, no
+// players to hand conquered territories to)
 bool Deploy::execute() const {
-    if (!validate()) return false;
-    // actual logic would go here
+    ExecutionContext ctx;
+    return execute(ctx);
+}
+
+// validate against the game: only onto your own territory
+bool Deploy::validate(const ExecutionContext&) const {
+    return validate() && canDeploy(player, targ);
+}
+
+// execute: add the armies to the target
+bool Deploy::execute(ExecutionContext& ctx) const {
+    if (!validate(ctx)) return false;
+    applyDeploy(targ, armyNum);
     return true;
 }
 
@@ -147,51 +384,45 @@ Deploy* Deploy::clone() const {
     return new Deploy(*this);
 }
 
+// compact form for the record mode of OrdersList
+OrderRecord Deploy::toRecord() const {
+    return OrderRecord{OrderKind::Deploy, idOf(player), slotOf(targ), -1, armyNum};
+}
+
 // ================= Advance =================
 
 // default constructor
 Advance::Advance() : Orders(nullptr) {
     targ = nullptr;
     source = nullptr;
-    armyNum = nullptr;
+    armyNum = 0;
 }
 
 // parameterized constructor
-Advance::Advance(Player* playr, Territory* target, Territory* source, int* armynum) {
-    this->player = playr;
+Advance::Advance(Player* playr, Territory* target, Territory* source, int armynum) : Orders(playr) {
     this->targ = target;
     this->source = source;
     this->armyNum = armynum;
 }
 
 // copy constructor
-Advance::Advance(const Advance& order) {
-    player = new Player(*order.player);
-    targ = new Territory(*order.targ);
-    source = new Territory(*order.source);
-    armyNum = new int(*order.armyNum);
+Advance::Advance(const Advance& order) : Orders(order) {
+    targ = order.targ;
+    source = order.source;
+    armyNum = order.armyNum;
 }
 
 // destructor
 Advance::~Advance() {
-    delete player;
-    delete targ;
-    delete source;
-    delete armyNum;
 }
 
 // assignment operator
 Advance& Advance::operator=(const Advance& order) {
     if (this != &order) {
-        if (this->player != nullptr) delete player;
-        if (this->targ != nullptr) delete targ;
-        if (this->source != nullptr) delete source;
-        if (this->armyNum != nullptr) delete armyNum;
-
-        this->player = new Player(*order.player);
-        this->targ = new Territory(*order.targ);
-        this->source = new Territory(*order.source);
-        this->armyNum = new int(*order.armyNum);
+        Orders::operator=(order);
+        this->targ = order.targ;
+        this->source = order.source;
+        this->armyNum = order.armyNum;
     }
     return *this;
 }
@@ -199,56 +430,61 @@ Advance& Advance::operator=(const Advance& order) {
 // stream insertion
 std::ostream& operator<<(std::ostream& os, const Advance& order) {
     os << "This is an Advance order belonging to " << order.player
-       << " to Advance " << *order.armyNum
+       << " to Advance " << order.armyNum
        << " armies to the territory " << order.targ
        << " from source territory " << order.source;
     return os;
 }
 
 // getters/setters
-Player Advance::getPlayer() const {
-    return *player;
-}
-
-void Advance::setPlayer(Player playr) {
-    *this->player = playr;
+Territory* Advance::getTarg() const {
+    return targ;
 }
 
-Territory Advance::getTarg() const {
-    return *targ;
+void Advance::setTarget(Territory* targ) {
+    this->targ = targ;
 }
 
-void Advance::setTarget(Territory targ) {
-    *this->targ = targ;
+Territory* Advance::getSource() const {
+    return source;
 }
 
-Territory Advance::getSource() const {
-    return *source;
-}
-
-void Advance::setSource(Territory source) {
-    *this->source = source;
+void Advance::setSource(Territory* source) {
+    this->source = source;
 }
 
 int Advance::getArmynum() const {
-    return *armyNum;
+    return armyNum;
 }
 
 void Advance::setArmynum(int armies) {
-    *armyNum = armies;
+    armyNum = armies;
 }
 
 // validate
 bool Advance::validate() const {
-    if (player == nullptr || targ == nullptr || source == nullptr || *armyNum <= 0) return false;
+    if (player == nullptr || targ == nullptr || source == nullptr || armyNum <= 0) return false;
     // NOTE: placeholder, adapt to your Player/Territory API
     return true;
 }
 
-// execute
+// execute without a game: fresh context (combat seed 0, no truces, no
+// players to hand conquered territories to)
 bool Advance::execute() const {
-    if (!validate()) return false;
-    return true;
+    ExecutionContext ctx;
+    return execute(ctx);
+}
+
+// validate against the game: from your own territory to an adjacent one,
+// not into a player you negotiated with this round
+bool Advance::validate(const ExecutionContext& ctx) const {
+    return validate() && canAdvance(ctx, player, source, targ);
+}
+
+// execute: move between own territories, otherwise attack
+bool Advance::execute(ExecutionContext& ctx) const {
+    if (!validate(ctx)) return false;
+    return applyMove(ctx, player, source, targ, armyNum);
 }
 
 // clone
@@ -256,6 +492,11 @@ Advance* Advance::clone() const {
     return new Advance(*this);
 }
 
+// compact form for the record mode of OrdersList
+OrderRecord Advance::toRecord() const {
+    return OrderRecord{OrderKind::Advance, idOf(player), slotOf(targ), slotOf(source), armyNum};
+}
+
 
 // ================= Bomb =================
 
@@ -265,31 +506,24 @@ Bomb::Bomb() : Orders(nullptr) {
 }
 
 // parameterized constructor
-Bomb::Bomb(Player* playr, Territory* target) {
-    this->player = playr;
+Bomb::Bomb(Player* playr, Territory* target) : Orders(playr) {
     this->targ = target;
 }
 
 // copy constructor
-Bomb::Bomb(const Bomb& order) {
-    player = new Player(*order.player);
-    targ = new Territory(*order.targ);
+Bomb::Bomb(const Bomb& order) : Orders(order) {
+    targ = order.targ;
 }
 
 // destructor
 Bomb::~Bomb() {
-    delete player;
-    delete targ;
 }
 
 // assignment operator
 Bomb& Bomb::operator=(const Bomb& order) {
     if (this != &order) {
-        if (this->player != nullptr) delete player;
-        if (this->targ != nullptr) delete targ;
-
-        this->player = new Player(*order.player);
-        this->targ = new Territory(*order.targ);
+        Orders::operator=(order);
+        this->targ = order.targ;
     }
     return *this;
 }
@@ -302,20 +536,12 @@ std::ostream& operator<<(std::ostream& os, const Bomb& order) {
 }
 
 // getters/setters
-Player Bomb::getPlayer() const {
-    return *player;
-}
-
-void Bomb::setPlayer(Player playr) {
-    *this->player = playr;
-}
-
-Territory Bomb::getTarg() const {
-    return *targ;
+Territory* Bomb::getTarg() const {
+    return targ;
 }
 
-void Bomb::setTarget(Territory targ) {
-    *this->targ = targ;
+void Bomb::setTarget(Territory* targ) {
+    this->targ = targ;
 }
 
 // validate
@@ -325,9 +551,23 @@ bool Bomb::validate() const {
     return true;
 }
 
-// execute
+// execute without a game: fresh context (combat seed 0, no truces, no
+// players to hand conquered territories to)
 bool Bomb::execute() const {
-    if (!validate()) return false;
+    ExecutionContext ctx;
+    return execute(ctx);
+}
+
+// validate against the game: an enemy territory next to one of yours, and
+// not owned by a player you negotiated with this round
+bool Bomb::validate(const ExecutionContext& ctx) const {
+    return validate() && canBomb(ctx, player, targ);
+}
+
+// execute: halve the target's armies (rounding down)
+bool Bomb::execute(ExecutionContext& ctx) const {
+    if (!validate(ctx)) return false;
+    applyBomb(targ);
     return true;
 }
 
@@ -336,6 +576,11 @@ Bomb* Bomb::clone() const {
     return new Bomb(*this);
 }
 
+// compact form for the record mode of OrdersList
+OrderRecord Bomb::toRecord() const {
+    return OrderRecord{OrderKind::Bomb, idOf(player), slotOf(targ), -1, 0};
+}
+
 // ================= Blockade =================
 
 // default constructor
@@ -344,31 +589,24 @@ Blockade::Blockade() : Orders(nullptr) {
 }
 
 // parameterized constructor
-Blockade::Blockade(Player* playr, Territory* target) {
-    this->player = playr;
+Blockade::Blockade(Player* playr, Territory* target) : Orders(playr) {
     this->targ = target;
 }
 
 // copy constructor
-Blockade::Blockade(const Blockade& order) {
-    player = new Player(*order.player);
-    targ = new Territory(*order.targ);
+Blockade::Blockade(const Blockade& order) : Orders(order) {
+    targ = order.targ;
 }
 
 // destructor
 Blockade::~Blockade() {
-    delete player;
-    delete targ;
 }
 
 // assignment operator
 Blockade& Blockade::operator=(const Blockade& order) {
     if (this != &order) {
-        if (this->player != nullptr) delete player;
-        if (this->targ != nullptr) delete targ;
-
-        this->player = new Player(*order.player);
-        this->targ = new Territory(*order.targ);
+        Orders::operator=(order);
+        this->targ = order.targ;
     }
     return *this;
 }
@@ -381,20 +619,12 @@ std::ostream& operator<<(std::ostream& os, const Blockade& order) {
 }
 
 // getters/setters
-Player Blockade::getPlayer() const {
-    return *player;
-}
-
-void Blockade::setPlayer(Player playr) {
-    *this->player = playr;
+Territory* Blockade::getTarg() const {
+    return targ;
 }
 
-Territory Blockade::getTarg() const {
-    return *targ;
-}
-
-void Blockade::setTarget(Territory targ) {
-    *this->targ = targ;
+void Blockade::setTarget(Territory* targ) {
+    this->targ = targ;
 }
 
 // validate
@@ -404,9 +634,22 @@ bool Blockade::validate() const {
     return true;
 }
 
-// execute
+// execute without a game: fresh context (combat seed 0, no truces, no
+// players to hand conquered territories to)
 bool Blockade::execute() const {
-    if (!validate()) return false;
+    ExecutionContext ctx;
+    return execute(ctx);
+}
+
+// validate against the game: only your own territory
+bool Blockade::validate(const ExecutionContext&) const {
+    return validate() && canBlockade(player, targ);
+}
+
+// execute: double the armies and hand the territory to the Neutral player
+bool Blockade::execute(ExecutionContext& ctx) const {
+    if (!validate(ctx)) return false;
+    applyBlockade(ctx, targ);
     return true;
 }
 
@@ -415,6 +658,11 @@ Blockade* Blockade::clone() const {
     return new Blockade(*this);
 }
 
+// compact form for the record mode of OrdersList
+OrderRecord Blockade::toRecord() const {
+    return OrderRecord{OrderKind::Blockade, idOf(player), slotOf(targ), -1, 0};
+}
+
 
 
 // ================= Airlift =================
@@ -423,45 +671,34 @@ Blockade* Blockade::clone() const {
 Airlift::Airlift() : Orders(nullptr) {
     targ = nullptr;
     source = nullptr;
-    armyNum = nullptr;
+    armyNum = 0;
 }
 
 // parameterized constructor
-Airlift::Airlift(Player* playr, Territory* target, Territory* source, int* armynum) {
-    this->player = playr;
+Airlift::Airlift(Player* playr, Territory* target, Territory* source, int armynum) : Orders(playr) {
     this->targ = target;
     this->source = source;
     this->armyNum = armynum;
 }
 
 // copy constructor
-Airlift::Airlift(const Airlift& order) {
-    player = new Player(*order.player);
-    targ = new Territory(*order.targ);
-    source = new Territory(*order.source);
-    armyNum = new int(*order.armyNum);
+Airlift::Airlift(const Airlift& order) : Orders(order) {
+    targ = order.targ;
+    source = order.source;
+    armyNum = order.armyNum;
 }
 
 // destructor
 Airlift::~Airlift() {
-    delete player;
-    delete targ;
-    delete source;
-    delete armyNum;
 }
 
 // assignment operator
 Airlift& Airlift::operator=(const Airlift& order) {
     if (this != &order) {
-        if (this->player != nullptr) delete player;
-        if (this->targ != nullptr) delete targ;
-        if (this->source != nullptr) delete source;
-        if (this->armyNum != nullptr) delete armyNum;
-
-        this->player = new Player(*order.player);
-        this->targ = new Territory(*order.targ);
-        this->source = new Territory(*order.source);
-        this->armyNum = new int(*order.armyNum);
+        Orders::operator=(order);
+        this->targ = order.targ;
+        this->source = order.source;
+        this->armyNum = order.armyNum;
     }
     return *this;
 }
@@ -469,56 +706,62 @@ Airlift& Airlift::operator=(const Airlift& order) {
 // stream insertion
 std::ostream& operator<<(std::ostream& os, const Airlift& order) {
     os << "This is an Airlift order belonging to " << order.player
-       << " to Airlift " << *order.armyNum
+       << " to Airlift " << order.armyNum
        << " armies to the territory " << order.targ
        << " from source territory " << order.source;
     return os;
 }
 
 // getters/setters
-Player Airlift::getPlayer() const {
-    return *player;
+Territory* Airlift::getTarg() const {
+    return targ;
 }
 
-void Airlift::setPlayer(Player playr) {
-    *this->player = playr;
+void Airlift::setTarget(Territory* targ) {
+    this->targ = targ;
 }
 
-Territory Airlift::getTarg() const {
-    return *targ;
+Territory* Airlift::getSource() const {
+    return source;
 }
 
-void Airlift::setTarget(Territory targ) {
-    *this->targ = targ;
-}
-
-Territory Airlift::getSource() const {
-    return *source;
-}
-
-void Airlift::setSource(Territory source) {
-    *this->source = source;
+void Airlift::setSource(Territory* source) {
+    this->source = source;
 }
 
 int Airlift::getArmynum() const {
-    return *armyNum;
+    return armyNum;
 }
 
 void Airlift::setArmynum(int armies) {
-    *armyNum = armies;
+    armyNum = armies;
 }
 
 // validate
 bool Airlift::validate() const {
-    if (player == nullptr || targ == nullptr || source == nullptr || *armyNum <= 0) return false;
+    if (player == nullptr || targ == nullptr || source == nullptr || armyNum <= 0) return false;
     // NOTE: adjust to your rules
     return true;
 }
 
-// execute
+// execute without a game: fresh context (combat seed 0, no truces, no
+// players to hand conquered territories to)
 bool Airlift::execute() const {
-    if (!validate()) return false;
-    return true;
+    ExecutionContext ctx;
+    return execute(ctx);
+}
+
+// validate against the game: from your own territory to any other one (no
+// adjacency needed), not into a player you negotiated with this round
+bool Airlift::validate(const ExecutionContext& ctx) const {
+    return validate() && canAirlift(ctx, player, source, targ);
+}
+
+// execute: move up to armyNum armies from source to target; an airlift into
+// an enemy territory fights the same battle as an Advance
+bool Airlift::execute(ExecutionContext& ctx) const {
+    if (!validate(ctx)) return false;
+    return applyMove(ctx, player, source, targ, armyNum);
 }
 
 // clone
@@ -526,6 +769,11 @@ Airlift* Airlift::clone() const {
     return new Airlift(*this);
 }
 
+// compact form for the record mode of OrdersList
+OrderRecord Airlift::toRecord() const {
+    return OrderRecord{OrderKind::Airlift, idOf(player), slotOf(targ), slotOf(source), armyNum};
+}
+
 
 
 // ================= Negotiate =================
@@ -536,31 +784,24 @@ Negotiate::Negotiate() : Orders(nullptr) {
 }
 
 // parameterized constructor
-Negotiate::Negotiate(Player* playr, Player* target) {
-    this->player = playr;
+Negotiate::Negotiate(Player* playr, Player* target) : Orders(playr) {
     this->targ = target;
 }
 
 // copy constructor
-Negotiate::Negotiate(const Negotiate& order) {
-    player = new Player(*order.player);
-    targ = new Player(*order.targ);
+Negotiate::Negotiate(const Negotiate& order) : Orders(order) {
+    targ = order.targ;
 }
 
 // destructor
 Negotiate::~Negotiate() {
-    delete player;
-    delete targ;
 }
 
 // assignment operator
 Negotiate& Negotiate::operator=(const Negotiate& order) {
     if (this != &order) {
-        if (this->player != nullptr) delete player;
-        if (this->targ != nullptr) delete targ;
-
-        this->player = new Player(*order.player);
-        this->targ = new Player(*order.targ);
+        Orders::operator=(order);
+        this->targ = order.targ;
     }
     return *this;
 }
@@ -573,20 +814,12 @@ std::ostream& operator<<(std::ostream& os, const Negotiate& order) {
 }
 
 // getters/setters
-Player Negotiate::getPlayer() const {
-    return *player;
-}
-
-void Negotiate::setPlayer(Player playr) {
-    *this->player = playr;
+Player* Negotiate::getTarget() const {
+    return targ;
 }
 
-Player Negotiate::getTarget() const {
-    return *targ;
-}
-
-void Negotiate::setTarget(Player targ) {
-    *this->targ = targ;
+void Negotiate::setTarget(Player* targ) {
+    this->targ = targ;
 }
 
 // validate
@@ -595,9 +828,22 @@ bool Negotiate::validate() const {
     return targ != player;
 }
 
-// execute
+// execute without a game: fresh context (combat seed 0, no truces, no
+// players to hand conquered territories to)
 bool Negotiate::execute() const {
-    if (!validate()) return false;
+    ExecutionContext ctx;
+    return execute(ctx);
+}
+
+// validate against the game: another player, both with ids in the game
+bool Negotiate::validate(const ExecutionContext&) const {
+    return validate() && canNegotiate(player, targ);
+}
+
+// execute: no attacks between the two players for the rest of the round
+bool Negotiate::execute(ExecutionContext& ctx) const {
+    if (!validate(ctx)) return false;
+    applyNegotiate(ctx, player, targ);
     return true;
 }
 
@@ -606,18 +852,155 @@ Negotiate* Negotiate::clone() const {
     return new Negotiate(*this);
 }
 
+// compact form for the record mode of OrdersList
+OrderRecord Negotiate::toRecord() const {
+    return OrderRecord{OrderKind::Negotiate, idOf(player), idOf(targ), -1, 0};
+}
+
+// ================= RecordArena =================
+
+RecordArena::RecordArena() {
+    chunks = new std::vector<OrderRecord*>();
+    count = 0;
+}
+
+// copy constructor (only the live records)
+RecordArena::RecordArena(const RecordArena& other) {
+    chunks = new std::vector<OrderRecord*>();
+    count = 0;
+    for (int i = 0; i < other.count; i++) push(other.at(i));
+}
+
+RecordArena& RecordArena::operator=(const RecordArena& other) {
+    if (this != &other) {
+        count = 0;   // keep our chunks
+        for (int i = 0; i < other.count; i++) push(other.at(i));
+    }
+    return *this;
+}
+
+RecordArena::~RecordArena() {
+    for (auto* chunk : *chunks) delete[] chunk;
+    delete chunks;
+}
+
+OrderRecord* RecordArena::push(const OrderRecord& record) {
+    if (count == capacity()) chunks->push_back(new OrderRecord[CHUNK]);
+    OrderRecord* slot = &at(count++);
+    *slot = record;
+    return slot;
+}
+
+// ================= Record execution =================
+
+int priorityOf(OrderKind kind) {
+    switch (kind) {
+        case OrderKind::Deploy:   return OrderScheduler::DEPLOY;
+        case OrderKind::Airlift:  return OrderScheduler::AIRLIFT;
+        case OrderKind::Blockade: return OrderScheduler::BLOCKADE;
+        default:                  return OrderScheduler::OTHER;
+    }
+}
+
+namespace {
+    // A record's player and territories, looked up from its indices
+    struct RecordRefs {
+        Player* player = nullptr;
+        Player* other = nullptr;      // Negotiate
+        Territory* targ = nullptr;
+        Territory* source = nullptr;  // Advance/Airlift
+    };
+
+    // false if any index the kind needs is out of range
+    bool resolveRecord(const OrderRecord& r, const ExecutionContext& ctx, RecordRefs& refs) {
+        if (ctx.players == nullptr) return false;
+        const int nPlayers = (int)ctx.players->size();
+        if (r.player < 0 || r.player >= nPlayers) return false;
+        refs.player = (*ctx.players)[r.player];
+
+        if (r.kind == OrderKind::Negotiate) {
+            if (r.target < 0 || r.target >= nPlayers || r.target == r.player) return false;
+            refs.other = (*ctx.players)[r.target];
+            return true;
+        }
+
+        if (ctx.map == nullptr) return false;
+        const TerritoryStore* store = ctx.map->getStore();
+        auto territory = [store](int slot) -> Territory* {
+            return slot >= 0 && slot < store->size() ? store->handle(slot) : nullptr;
+        };
+        refs.targ = territory(r.target);
+        if (refs.targ == nullptr) return false;
+        if (r.kind == OrderKind::Advance || r.kind == OrderKind::Airlift) {
+            refs.source = territory(r.source);
+            if (refs.source == nullptr) return false;
+        }
+        return true;
+    }
+
+    bool validateRecord(const OrderRecord& r, const ExecutionContext& ctx, const RecordRefs& refs) {
+        switch (r.kind) {
+            case OrderKind::Deploy:    return r.armies > 0 && canDeploy(refs.player, refs.targ);
+            case OrderKind::Advance:   return r.armies > 0 && canAdvance(ctx, refs.player, refs.source, refs.targ);
+            case OrderKind::Airlift:   return r.armies > 0 && canAirlift(ctx, refs.player, refs.source, refs.targ);
+            case OrderKind::Bomb:      return canBomb(ctx, refs.player, refs.targ);
+            case OrderKind::Blockade:  return canBlockade(refs.player, refs.targ);
+            case OrderKind::Negotiate: return canNegotiate(refs.player, refs.other);
+            default:                   return false;
+        }
+    }
+}
+
+bool validateRecord(const OrderRecord& r, const ExecutionContext& ctx) {
+    RecordRefs refs;
+    return resolveRecord(r, ctx, refs) && validateRecord(r, ctx, refs);
+}
+
+bool executeRecord(const OrderRecord& r, ExecutionContext& ctx) {
+    RecordRefs refs;
+    if (!resolveRecord(r, ctx, refs) || !validateRecord(r, ctx, refs)) return false;
+
+    switch (r.kind) {
+        case OrderKind::Deploy:
+            applyDeploy(refs.targ, r.armies);
+            return true;
+        case OrderKind::Advance:
+        case OrderKind::Airlift:
+            return applyMove(ctx, refs.player, refs.source, refs.targ, r.armies);
+        case OrderKind::Bomb:
+            applyBomb(refs.targ);
+            return true;
+        case OrderKind::Blockade:
+            applyBlockade(ctx, refs.targ);
+            return true;
+        case OrderKind::Negotiate:
+            applyNegotiate(ctx, refs.player, refs.other);
+            return true;
+        default:
+            return false;
+    }
+}
+
 // ================= OrdersList =================
 
 // default constructor
 OrdersList::OrdersList() {
     orders = new std::vector<Orders*>();   // allocate empty vector
+    records = nullptr;
+}
+
+// storage mode constructor
+OrdersList::OrdersList(OrdersStorage mode) {
+    orders = new std::vector<Orders*>();
+    records = mode == OrdersStorage::Records ? new RecordArena() : nullptr;
 }
 
 // copy constructor
 OrdersList::OrdersList(const OrdersList& other) {
     orders = new std::vector<Orders*>();
+    records = other.records ? new RecordArena(*other.records) : nullptr;
     for (int i = 0; i < other.orders->size(); i++) {
-        Orders* ord = other.orders->at(i)->clone(); // deep copy using clone
+        Orders* ord = other.orders->at(i)->clone(); // new order, same player/territories
         this->orders->push_back(ord);
     }
 }
@@ -629,6 +1012,7 @@ OrdersList::~OrdersList() {
         delete ord;
     }
     delete orders;  // free vector itself
+    delete records;
 }
 
 // assignment operator
@@ -640,17 +1024,25 @@ OrdersList& OrdersList::operator=(const OrdersList& other) {
         }
         orders->clear();
 
-        // deep copy from other
+        // copy from other (orders only reference the game, see Orders)
         for (int i = 0; i < other.orders->size(); i++) {
             Orders* ord = other.orders->at(i)->clone();
             this->orders->push_back(ord);
         }
+
+        // same storage mode as other
+        delete records;
+        records = other.records ? new RecordArena(*other.records) : nullptr;
     }
     return *this;
 }
 
 // stream insertion operator
 std::ostream& operator<<(std::ostream& os, const OrdersList& orderList) {
+    if (orderList.records) {
+        os << "Orders: " << orderList.records->size() << " records.";
+        return os;
+    }
     os << "Orders: ";
     for (int i = 0; i < orderList.orders->size(); i++) {
         os << *orderList.orders->at(i);
@@ -674,8 +1066,13 @@ void OrdersList::setOrders(std::vector<Orders*> orderss) {
     *this->orders = orderss;
 }
 
-// add order
+// add order (Records mode keeps the compact form and frees the object)
 void OrdersList::add(Orders* order) {
+    if (records) {
+        records->push(order->toRecord());
+        delete order;
+        return;
+    }
     this->orders->push_back(order);
 }
 
@@ -705,3 +1102,240 @@ void OrdersList::move(Orders* order1, Orders* order2) {
     }
 }
 
+// size / indexed access for the execution pass
+int OrdersList::size() const {
+    return records ? records->size() : (int)orders->size();
+}
+
+Orders* OrdersList::at(int i) const {
+    return records ? nullptr : orders->at(i);
+}
+
+// delete every order, keep the (now empty) list
+void OrdersList::clear() {
+    for (auto* ord : *orders) {
+        delete ord;
+    }
+    orders->clear();
+    if (records) records->reset();
+}
+
+// ---- Records mode ----
+
+OrdersStorage OrdersList::storage() const {
+    return records ? OrdersStorage::Records : OrdersStorage::Objects;
+}
+
+// no-op in Objects mode
+void OrdersList::addRecord(const OrderRecord& record) {
+    if (records) records->push(record);
+}
+
+const OrderRecord& OrdersList::recordAt(int i) const {
+    return records->at(i);
+}
+
+const RecordArena* OrdersList::getRecords() const {
+    return records;
+}
+
+OrderKind OrdersList::kindAt(int i) const {
+    return records ? records->at(i).kind : orders->at(i)->toRecord().kind;
+}
+
+OrderRecord OrdersList::recordOf(int i) const {
+    return records ? records->at(i) : orders->at(i)->toRecord();
+}
+
+bool OrdersList::validateAt(int i, const ExecutionContext& ctx) const {
+    return records ? validateRecord(records->at(i), ctx) : orders->at(i)->validate(ctx);
+}
+
+bool OrdersList::executeAt(int i, ExecutionContext& ctx) const {
+    return records ? executeRecord(records->at(i), ctx) : orders->at(i)->execute(ctx);
+}
+
+// ================= Round execution =================
+
+int executeRound(const std::vector<Player*>& players, ExecutionContext& ctx) {
+    ctx.beginRound();
+
+    ctx.schedule.reset((int)players.size());
+    for (int p = 0; p < (int)players.size(); p++) {
+        OrdersList* list = players[p]->getOrder();
+        for (int i = 0; i < list->size(); i++) ctx.schedule.add(p, priorityOf(list->kindAt(i)), i);
+    }
+    ctx.schedule.merge(ctx.sequence);
+
+    // battle numbers follow sequence slots (an order fights at most once),
+    // so a planned round run group by group rolls the same dice
+    const unsigned long long firstBattle = ctx.battles;
+    for (int s = 0; s < (int)ctx.sequence.size(); s++) {
+        const ScheduledOrder& next = ctx.sequence[s];
+        ctx.battles = firstBattle + s;
+        if (players[next.player]->getOrder()->executeAt(next.index, ctx)) ctx.executed++;
+        else ctx.rejected++;
+    }
+    ctx.battles = firstBattle + ctx.sequence.size();
+
+    for (auto* p : players) p->getOrder()->clear();
+    return ctx.executed;
+}
+
+// ================= Round planning =================
+
+namespace {
+    // Union-find over territory slots, followed by one node per player
+    struct Partition {
+        std::vector<int> parent;
+        std::vector<int> rank;
+
+        explicit Partition(int n) : parent(n), rank(n, 0) {
+            for (int i = 0; i < n; i++) parent[i] = i;
+        }
+
+        int find(int x) {
+            while (parent[x] != x) {
+                parent[x] = parent[parent[x]];   // path halving
+                x = parent[x];
+            }
+            return x;
+        }
+
+        void join(int a, int b) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return;
+            if (rank[a] < rank[b]) std::swap(a, b);
+            parent[b] = a;
+            if (rank[a] == rank[b]) rank[a]++;
+        }
+    };
+}
+
+RoundPlan planRound(const std::vector<Player*>& players, ExecutionContext& ctx, ThreadPool* pool) {
+    ctx.beginRound();
+    RoundPlan plan;
+
+    const int nPlayers = (int)players.size();
+    ctx.schedule.reset(nPlayers);
+    for (int p = 0; p < nPlayers; p++) {
+        OrdersList* list = players[p]->getOrder();
+        for (int i = 0; i < list->size(); i++) ctx.schedule.add(p, priorityOf(list->kindAt(i)), i);
+    }
+    ctx.schedule.merge(plan.sequence);
+    const int n = (int)plan.sequence.size();
+
+    // ---- validation: read-only, so chunks can run side by side ----
+    plan.valid.assign(n, 0);
+    auto validateRange = [&plan, &players, &ctx](int from, int to) {
+        for (int s = from; s < to; s++) {
+            const ScheduledOrder& e = plan.sequence[s];
+            plan.valid[s] = players[e.player]->getOrder()->validateAt(e.index, ctx) ? 1 : 0;
+        }
+    };
+    if (pool == nullptr || pool->size() <= 1 || n < 256) {
+        validateRange(0, n);
+    } else {
+        const int chunks = std::min(n, pool->size() * 4);
+        std::vector<std::future<void>> done;
+        done.reserve(chunks);
+        for (int c = 0; c < chunks; c++) {
+            const int from = (int)((long long)n * c / chunks);
+            const int to = (int)((long long)n * (c + 1) / chunks);
+            done.push_back(pool->submit([&validateRange, from, to]() { validateRange(from, to); }));
+        }
+        for (auto& f : done) f.get();
+    }
+    for (int s = 0; s < n; s++) if (!plan.valid[s]) plan.invalid++;
+
+    // ---- footprints: which orders touch which territories ----
+    const TerritoryStore* store = ctx.map ? ctx.map->getStore() : nullptr;
+    const int slots = store ? store->size() : 0;
+    Partition part(slots + nPlayers);
+    std::vector<OrderRecord> recs(n);
+    std::vector<int> anchor(n, -1);          // a node the order is joined to
+    std::vector<int> writes(slots, 0);
+    std::vector<int> written;                // slots with writes > 0
+    std::vector<char> negotiating(nPlayers, 0);
+    auto inMap = [slots](int slot) { return slot >= 0 && slot < slots; };
+    auto write = [&](int slot) {
+        if (!inMap(slot)) return;
+        if (writes[slot]++ == 0) written.push_back(slot);
+    };
+
+    for (int s = 0; s < n; s++) {
+        const ScheduledOrder& e = plan.sequence[s];
+        const OrderRecord r = players[e.player]->getOrder()->recordOf(e.index);
+        recs[s] = r;
+        if (r.kind == OrderKind::Negotiate) {
+            if (r.target < 0 || r.target >= nPlayers) continue;
+            negotiating[e.player] = 1;
+            negotiating[r.target] = 1;
+            part.join(slots + e.player, slots + r.target);
+            anchor[s] = slots + e.player;
+            continue;
+        }
+        if (!inMap(r.target)) continue;
+        anchor[s] = r.target;
+        write(r.target);
+        if (r.kind == OrderKind::Advance || r.kind == OrderKind::Airlift) {
+            if (inMap(r.source)) {
+                part.join(r.target, r.source);
+                write(r.source);
+            }
+        } else if (r.kind == OrderKind::Bomb) {
+            for (int nb : store->neighbors(r.target)) part.join(r.target, nb);
+        }
+    }
+    // truces only matter to the two players' own orders
+    for (int s = 0; s < n; s++) {
+        const int p = plan.sequence[s].player;
+        if (negotiating[p] && anchor[s] >= 0) part.join(anchor[s], slots + p);
+    }
+
+    for (int slot : written) {
+        if (writes[slot] > 1) plan.conflicts.push_back(TerritoryConflict{slot, writes[slot]});
+    }
+    std::sort(plan.conflicts.begin(), plan.conflicts.end(),
+              [](const TerritoryConflict& a, const TerritoryConflict& b) { return a.territory < b.territory; });
+
+    // ---- groups, numbered by first appearance in the sequence ----
+    // (an order with nothing to anchor it, e.g. bad indices, is a group of its own)
+    std::vector<int> groupOfRoot(slots + nPlayers, -1);
+    plan.group.assign(n, -1);
+    for (int s = 0; s < n; s++) {
+        if (anchor[s] < 0) {
+            plan.group[s] = plan.groups++;
+            continue;
+        }
+        int& g = groupOfRoot[part.find(anchor[s])];
+        if (g < 0) g = plan.groups++;
+        plan.group[s] = g;
+    }
+    plan.groupOffsets.assign(plan.groups + 1, 0);
+    for (int s = 0; s < n; s++) plan.groupOffsets[plan.group[s] + 1]++;
+    for (int g = 0; g < plan.groups; g++) plan.groupOffsets[g + 1] += plan.groupOffsets[g];
+    plan.groupOrders.resize(n);
+    std::vector<int> fill(plan.groupOffsets.begin(), plan.groupOffsets.end() - 1);
+    for (int s = 0; s < n; s++) plan.groupOrders[fill[plan.group[s]]++] = s;
+    return plan;
+}
+
+int executeRound(const std::vector<Player*>& players, ExecutionContext& ctx, const RoundPlan& plan) {
+    ctx.beginRound();
+    const unsigned long long firstBattle = ctx.battles;
+    for (int g = 0; g < plan.groups; g++) {
+        for (int k = plan.groupOffsets[g]; k < plan.groupOffsets[g + 1]; k++) {
+            const int s = plan.groupOrders[k];
+            const ScheduledOrder& next = plan.sequence[s];
+            ctx.battles = firstBattle + s;
+            if (players[next.player]->getOrder()->executeAt(next.index, ctx)) ctx.executed++;
+            else ctx.rejected++;
+        }
+    }
+    ctx.battles = firstBattle + plan.sequence.size();
+
+    for (auto* p : players) p->getOrder()->clear();
+    return ctx.executed;
+}
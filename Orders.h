@@ -1,17 +1,144 @@
 #pragma once
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <utility>
 #include <vector>
 #include "Player.h"
 #include "Map.h"
+#include "Combat.h"
+#include "OrderScheduler.h"
+
+class Player;
+class ThreadPool;
 
 //create Orders class, and the subclasses are the deploy, attack, negotiate, etc. user input determines which subclass is created 
 //(and can also make invalid order that's placed in list and then jsut ignored)
 //Orderlist class will hold the orders
 
+// ================= TruceTable =================
+// This round's truces as a bit matrix indexed by player id (Player::getId()).
+// Both (a, b) and (b, a) are set, so a lookup is one load and a mask.
+// clear() zeroes only the rows that were written (at most one per player).
+class TruceTable {
+private:
+	int players;
+	int words;                         // 64-bit words per row
+	std::vector<std::uint64_t> bits;   // players * words
+	std::vector<int> dirty;            // rows with a bit set
+	std::vector<char> rowDirty;
+
+	void markDirty(int row);
+
+public:
+	TruceTable();
+
+	void reset(int players);     // size for `players` ids and clear
+	void clear();
+	void add(int a, int b);      // grows for bigger ids; negative ids are ignored
+	bool atTruce(int a, int b) const {
+		if (a < 0 || b < 0 || a >= players || b >= players) return false;
+		return (bits[(std::size_t)a * words + (b >> 6)] >> (b & 63)) & 1u;
+	}
+	int size() const { return players; }
+	bool empty() const { return dirty.empty(); }
+};
+
+// Everything order execution changes, by value (ExecutionContext::snapshot)
+struct GameSnapshot {
+	MapState map;
+	std::vector<std::vector<int>> holdings;   // per player, Neutral last: territory slots in list order
+	unsigned long long battles = 0;
+	unsigned topology = 0;                    // store version the slots belong to
+};
+
+// ================= ExecutionContext =================
+// State shared by every order executed in a round. GameEngine keeps one for
+// the whole game (so battle numbers keep counting across rounds) and calls
+// beginRound() before each execution pass.
+struct ExecutionContext {
+	Map* map = nullptr;                          // may be null for loose territories (drivers)
+	const std::vector<Player*>* players = nullptr;   // used to find a territory's owner
+	Player* neutral = nullptr;                   // receives blockaded territories
+	CombatKernel combat;                         // battle rolls (seed with combat.setSeed)
+	unsigned long long battles = 0;              // battle number for the next fight (never reset;
+	                                             // executeRound gives each sequence slot its own)
+	TruceTable truces;                           // this round's Negotiates, by player id
+
+	int executed = 0;   // this round
+	int rejected = 0;   // failed validation this round
+
+	OrderScheduler schedule;                 // executeRound's queues, reused every round
+	std::vector<ScheduledOrder> sequence;    // and the merged order it produced
+
+	void beginRound();
+	bool atTruce(const Player* a, const Player* b) const;   // O(1), false without ids
+	Player* ownerOf(const Territory* t) const;   // nullptr if no known player owns it
+	void transfer(Territory* t, Player* to);     // owner name + both players' lists (to may be null)
+
+	// What-if search. snapshot()/restore() copy everything execution changes
+	// (owners, armies, players' territory lists, battle counter): O(map).
+	// For O(changes), attach a StateJournal to the map's store and roll back
+	// to a mark: owners and armies return, and every territory that changed
+	// hands goes back on its old owner's list (at the end). The battle
+	// counter keeps going, so a retried order set rolls fresh dice.
+	GameSnapshot snapshot() const;
+	bool restore(const GameSnapshot& s);   // false if the map's territories changed since
+	void rollback(StateJournal& journal, StateJournal::Mark mark);
+};
+
+// ================= Compact order records =================
+// Plain-data form of an order, used by the record mode of OrdersList.
+// Players are indices into the game's player list (Player::getId()) and
+// territories are slots in the map's store (Territory::getIndex()).
+enum class OrderKind : unsigned char { Deploy, Advance, Bomb, Blockade, Airlift, Negotiate };
+
+struct OrderRecord {
+	OrderKind kind;
+	int player;
+	int target;    // territory slot (player index for Negotiate)
+	int source;    // territory slot for Advance/Airlift, -1 otherwise
+	int armies;    // 0 when the kind has none
+};
+
+// Execution priority of a kind (OrderScheduler::DEPLOY ... OTHER)
+int priorityOf(OrderKind kind);
+
+// Runs one record against the game (players and map from ctx). Same rules as
+// the order classes; false if invalid (including bad indices).
+bool executeRecord(const OrderRecord& record, ExecutionContext& ctx);
+// Just the checks of executeRecord (reads the game, never writes it)
+bool validateRecord(const OrderRecord& record, const ExecutionContext& ctx);
+
+// Chunked bump allocator for OrderRecords. reset() only rewinds the count:
+// chunks stay allocated, so after the first round a list that stays the same
+// size never allocates again, and a record never moves while it is live.
+class RecordArena {
+private:
+	static const int CHUNK = 4096;
+	std::vector<OrderRecord*>* chunks;
+	int count;
+
+public:
+	RecordArena();
+	RecordArena(const RecordArena& other);
+	RecordArena& operator=(const RecordArena& other);
+	~RecordArena();
+
+	OrderRecord* push(const OrderRecord& record);
+	OrderRecord& at(int i) { return (*chunks)[i / CHUNK][i % CHUNK]; }
+	const OrderRecord& at(int i) const { return (*chunks)[i / CHUNK][i % CHUNK]; }
+	int size() const { return count; }
+	int capacity() const { return (int)chunks->size() * CHUNK; }
+	void reset() { count = 0; }
+};
+
 class Orders 
 {
 protected:
+	// Not owned: players belong to the GameEngine (or whoever made them) and
+	// territories to their Map. Copies share the same references, so copying
+	// an order or a whole OrdersList never copies game objects.
 	Player* player;
 
 public:
@@ -29,26 +156,31 @@ public:
 	friend std::ostream& operator<<(std::ostream& os, const Orders& order);
 
 	//getters
-	Player getPlayer() const;
+	Player* getPlayer() const;
 
 	//setters
-	void setPlayer(Player playr);
+	void setPlayer(Player* playr);
 
 	//methods needed:
 	virtual bool validate() const = 0;
 	virtual bool execute() const = 0;
 	virtual Orders* clone() const = 0;
+
+	// game rules (ownership, adjacency, truces) and the actual map mutation
+	virtual bool validate(const ExecutionContext& ctx) const = 0;
+	virtual bool execute(ExecutionContext& ctx) const = 0;
+	virtual OrderRecord toRecord() const = 0;
 };
 
 //subclasses
 class Deploy : public Orders {
 private:
 	Territory* targ;
-	int* armyNum;
+	int armyNum;
 public:
 	//constructors
 	Deploy();
-	Deploy(Player* player, Territory* target, int* armnum);
+	Deploy(Player* player, Territory* target, int armnum);
 
 	Deploy(const Deploy& order);
 
@@ -60,31 +192,32 @@ public:
 	friend std::ostream& operator<<(std::ostream& os, const Deploy& order);
 
 	//getters
-	Player getPlayer() const;
-	Territory getTarg() const;
+	Territory* getTarg() const;
 	int getArmynum() const;
 
 	//setters
-	void setPlayer(Player playr);
-	void setTarget(Territory target);
+	void setTarget(Territory* target);
 	void setArmynum(int armnum);
 
 	//methods needed:
 	virtual bool validate() const;
 	virtual bool execute() const;
 	virtual Deploy* clone() const;
+	virtual bool validate(const ExecutionContext& ctx) const;
+	virtual bool execute(ExecutionContext& ctx) const;
+	virtual OrderRecord toRecord() const;
 };
 
 class Advance : public Orders {
 private:
 	Territory* targ;
 	Territory* source;
-	int* armyNum;
+	int armyNum;
 
 public:
 	//constructors
 	Advance();
-	Advance(Player* player, Territory* targ, Territory* source, int* armnum);
+	Advance(Player* player, Territory* targ, Territory* source, int armnum);
 
 	Advance(const Advance& order);
 
@@ -96,21 +229,22 @@ public:
 	friend std::ostream& operator<<(std::ostream& os, const Advance& order);
 
 	//getters
-	Player getPlayer() const;
-	Territory getTarg() const;
-	Territory getSource() const;
+	Territory* getTarg() const;
+	Territory* getSource() const;
 	int getArmynum() const;
 
 	//setters
-	void setPlayer(Player playr);
-	void setTarget(Territory target);
-	void setSource(Territory source);
+	void setTarget(Territory* target);
+	void setSource(Territory* source);
 	void setArmynum(int armnum);
 
 	//methods needed:
 	virtual bool validate() const;
 	virtual bool execute() const;
 	virtual Advance* clone() const;
+	virtual bool validate(const ExecutionContext& ctx) const;
+	virtual bool execute(ExecutionContext& ctx) const;
+	virtual OrderRecord toRecord() const;
 };
 
 class Bomb : public Orders {
@@ -132,17 +266,18 @@ public:
 	friend std::ostream& operator<<(std::ostream& os, const Bomb& order);
 
 	//getters
-	Player getPlayer() const;
-	Territory getTarg() const;
+	Territory* getTarg() const;
 
 	//setters
-	void setPlayer(Player playr);
-	void setTarget(Territory target);
+	void setTarget(Territory* target);
 
 	//methods needed:
 	virtual bool validate() const;
 	virtual bool execute() const;
 	virtual Bomb* clone() const;
+	virtual bool validate(const ExecutionContext& ctx) const;
+	virtual bool execute(ExecutionContext& ctx) const;
+	virtual OrderRecord toRecord() const;
 };
 
 class Blockade : public Orders {
@@ -164,29 +299,30 @@ public:
 	friend std::ostream& operator<<(std::ostream& os, const Blockade& order);
 
 	//getters
-	Player getPlayer() const;
-	Territory getTarg() const;
+	Territory* getTarg() const;
 
 	//setters
-	void setPlayer(Player playr);
-	void setTarget(Territory target);
+	void setTarget(Territory* target);
 	
 	//methods needed:
 	virtual bool validate() const;
 	virtual bool execute() const;
 	virtual Blockade* clone() const;
+	virtual bool validate(const ExecutionContext& ctx) const;
+	virtual bool execute(ExecutionContext& ctx) const;
+	virtual OrderRecord toRecord() const;
 };
 
 class Airlift : public Orders {
 private:
 	Territory* targ;
 	Territory* source;
-	int* armyNum;
+	int armyNum;
 
 public:
 	//constructors
 	Airlift();
-	Airlift(Player* player, Territory* target, Territory* source, int* armnum);
+	Airlift(Player* player, Territory* target, Territory* source, int armnum);
 	Airlift(const Airlift& order);
 
 	//destructor
@@ -197,21 +333,22 @@ public:
 	friend std::ostream& operator<<(std::ostream& os, const Airlift& order);
 
 	//getters
-	Player getPlayer() const;
-	Territory getTarg() const;
-	Territory getSource() const;
+	Territory* getTarg() const;
+	Territory* getSource() const;
 	int getArmynum() const;
 
 	//setters
-	void setPlayer(Player playr);
-	void setTarget(Territory target);
-	void setSource(Territory source);
+	void setTarget(Territory* target);
+	void setSource(Territory* source);
 	void setArmynum(int armnum);
 
 	//methods needed:
 	virtual bool validate() const;
 	virtual bool execute() const;
 	virtual Airlift* clone() const;
+	virtual bool validate(const ExecutionContext& ctx) const;
+	virtual bool execute(ExecutionContext& ctx) const;
+	virtual OrderRecord toRecord() const;
 };
 
 class Negotiate : public Orders {
@@ -233,28 +370,37 @@ public:
 	friend std::ostream& operator<<(std::ostream& os, const Negotiate& order);
 
 	//getters
-	Player getPlayer() const;
-	Player getTarget() const;
+	Player* getTarget() const;
 
 	//setters
-	void setPlayer(Player playr);
-	void setTarget(Player targ);
+	void setTarget(Player* targ);
 
 	//methods needed:
 	virtual bool validate() const;
 	virtual bool execute() const;
 	virtual Negotiate* clone() const;
+	virtual bool validate(const ExecutionContext& ctx) const;
+	virtual bool execute(ExecutionContext& ctx) const;
+	virtual OrderRecord toRecord() const;
 };
 
+// Storage mode of an OrdersList:
+//  - Objects: heap Orders* (the original list, supports move/remove/at)
+//  - Records: OrderRecords in the list's own RecordArena; add() converts and
+//    frees the object, clear() is just a rewind
+enum class OrdersStorage { Objects, Records };
+
 class OrdersList
 {
 private:
 	std::vector<Orders*>* orders;
 	int length;
+	RecordArena* records;   // only in Records mode
 
 public:
 	//constructors
 	OrdersList();
+	explicit OrdersList(OrdersStorage mode);
 	OrdersList(const OrdersList& order);
 
 	//destructor
@@ -273,4 +419,68 @@ public:
 	void remove(Orders* order);
 	void add(Orders* order);
 	void move(Orders* order1, Orders* order2);
-};
\ No newline at end of file
+
+	int size() const;
+	Orders* at(int i) const;   // Objects mode only (nullptr in Records mode)
+	void clear();   // delete every order (after execution)
+
+	// Records mode
+	OrdersStorage storage() const;
+	void addRecord(const OrderRecord& record);
+	const OrderRecord& recordAt(int i) const;
+	const RecordArena* getRecords() const;
+
+	OrderKind kindAt(int i) const;   // either mode
+	OrderRecord recordOf(int i) const;   // either mode (by value)
+	bool validateAt(int i, const ExecutionContext& ctx) const;   // either mode, read-only
+
+	bool executeAt(int i, ExecutionContext& ctx) const;   // either mode
+};
+
+// Executes one round in Warzone order: all Deploys, then Airlifts, then
+// Blockades, then the rest; inside each level the first order of every
+// player, then the second, and so on (ctx.schedule builds the sequence).
+// Lists are cleared afterwards. Returns how many orders passed validation.
+int executeRound(const std::vector<Player*>& players, ExecutionContext& ctx);
+
+// ================= Round planning =================
+// Optional read-only pass before a round executes. Every order is validated
+// against the state at the start of the round (on a pool if one is given;
+// validation never writes). Then orders are grouped so that two groups
+// never touch the same territory. An order touches:
+//  - Deploy, Blockade: the target
+//  - Advance, Airlift: source and target
+//  - Bomb: the target, plus its neighbors (their owners decide validity)
+// and all orders of players in a Negotiate are joined with it (truces
+// decide their attacks). Groups are independent as far as the map and the
+// truces go. Only the players' territory lists are shared (and battle
+// numbers, which executeRound ties to sequence slots).
+//
+// valid[] is a forecast: earlier orders in the round can still change an
+// order's outcome, so execution re-checks every order.
+struct TerritoryConflict {
+	int territory;   // store slot
+	int orders;      // how many orders of the round write it
+};
+
+struct RoundPlan {
+	std::vector<ScheduledOrder> sequence;      // execution order, as executeRound
+	std::vector<unsigned char> valid;          // per sequence entry, at round start
+	int invalid = 0;
+	std::vector<int> group;                    // per sequence entry
+	int groups = 0;
+	// sequence entries of group g: groupOrders[groupOffsets[g] .. groupOffsets[g+1])
+	// (in sequence order inside a group)
+	std::vector<int> groupOffsets;
+	std::vector<int> groupOrders;
+	std::vector<TerritoryConflict> conflicts;  // territories written by more than one order
+};
+
+// Builds the plan for the orders currently in the players' lists. Starts the
+// round (ctx.beginRound()) so validation sees no leftover truces.
+RoundPlan planRound(const std::vector<Player*>& players, ExecutionContext& ctx, ThreadPool* pool = nullptr);
+
+// Executes a planned round group by group. The map ends up exactly as with
+// executeRound (conquests may be listed in a different order in the
+// players' territory lists). Lists are cleared afterwards.
+int executeRound(const std::vector<Player*>& players, ExecutionContext& ctx, const RoundPlan& plan);
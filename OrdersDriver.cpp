@@ -60,7 +60,7 @@ void testOrdersList() {
 
     // ===== Orders =====
     std::cout << "[DEBUG] Creating orders..." << std::endl;
-    int* num = new int(2);
+    int num = 2;
     Deploy*   dep = new Deploy(p2, t11, num);
     Blockade* blk = new Blockade(p2, t22);
     Advance*  adv = new Advance(p2, t11, t1, num);
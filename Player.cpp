@@ -5,6 +5,8 @@
 #include "Cards.h"
 #include "Orders.h"
 #include <string>
+#include <algorithm>
+#include <unordered_set>
 
 // ================= Constructors & Destructor =================
 
@@ -12,32 +14,47 @@
 Player::Player() {
     pName = new std::string;
     Pterritories = new std::vector<Territory*>;
+    territoryPos = new std::vector<int>;
     deck = new Deck;              // allocate Deck on heap
     order = new OrdersList;       // allocate OrdersList on heap
+    id = -1;
+    map = nullptr;
+    strategy = nullptr;
 }
 
 // parameterized constructor
 Player::Player(std::string pName1, std::vector<Territory*> t1, Deck* d1, OrdersList* o1) {
     this->pName = new std::string(pName1);
     this->Pterritories = new std::vector<Territory*>(t1);
+    this->territoryPos = new std::vector<int>;
+    indexTerritories();
     this->deck = d1;       // use provided Deck pointer
     this->order = o1;      // use provided OrdersList pointer
+    this->id = -1;
+    this->map = nullptr;
+    this->strategy = nullptr;
 }
 
 // copy constructor
 Player::Player(const Player& other) {
     pName = new std::string(*other.pName);
     Pterritories = new std::vector<Territory*>(*other.Pterritories);
+    territoryPos = new std::vector<int>(*other.territoryPos);
     deck = new Deck(*other.deck);
     order = new OrdersList(*other.order);
+    id = other.id;
+    map = other.map;
+    strategy = other.strategy ? other.strategy->clone() : nullptr;
 }
 
 // destructor
 Player::~Player() {
     delete pName;
     delete Pterritories;
+    delete territoryPos;
     delete deck;
     delete order;
+    delete strategy;
 }
 
 // ================= Getters =================
@@ -47,6 +64,11 @@ std::string Player::getPName() const {
     return *pName;
 }
 
+// getter for player index
+int Player::getId() const {
+    return id;
+}
+
 // getter for territory param
 std::vector<Territory*> Player::getTerritory() const {
     return *Pterritories;
@@ -62,6 +84,16 @@ OrdersList* Player::getOrder() const {
     return order;
 }
 
+// getter for the map being played
+Map* Player::getMap() const {
+    return map;
+}
+
+// getter for the strategy (nullptr: default orders)
+PlayerStrategy* Player::getStrategy() const {
+    return strategy;
+}
+
 // ================= Setters =================
 
 // setter for player name
@@ -69,9 +101,15 @@ void Player::setPName(std::string pName) {
     *this->pName = pName;
 }
 
+// setter for player index
+void Player::setId(int id) {
+    this->id = id;
+}
+
 // setter for territory
 void Player::setTerritory(std::vector<Territory*> Pterritories) {
     *this->Pterritories = Pterritories;
+    indexTerritories();
 }
 
 // setter for deck
@@ -84,61 +122,144 @@ void Player::setOrdersList(OrdersList* order) {
     *(this->order) = *order; // deep copy contents of provided orders list
 }
 
+// setter for the map being played (not owned)
+void Player::setMap(Map* map) {
+    this->map = map;
+}
+
+// setter for the strategy: replaces (and deletes) the old one
+void Player::setStrategy(PlayerStrategy* s) {
+    if (s == strategy) return;
+    delete strategy;
+    strategy = s;
+}
+
+// ================= Ownership Changes =================
+
+// Positions are kept by store slot. The entry is only a hint (checked
+// against the list before use): territories from different stores can
+// share a slot, and a slot can change hands when a map drops a territory.
+// A stale hint falls back to a scan.
+namespace {
+    void setPosition(std::vector<int>& positions, const Territory* t, int pos) {
+        const int slot = t->getIndex();
+        if (slot < 0) return;
+        if (slot >= (int)positions.size()) positions.resize(slot + 1, -1);
+        positions[slot] = pos;
+    }
+}
+
+int Player::positionOf(const Territory* t) const {
+    const int slot = t->getIndex();
+    if (slot >= 0 && slot < (int)territoryPos->size()) {
+        const int pos = (*territoryPos)[slot];
+        if (pos >= 0 && pos < (int)Pterritories->size() && (*Pterritories)[pos] == t) return pos;
+    }
+    auto it = std::find(Pterritories->begin(), Pterritories->end(), t);
+    return it == Pterritories->end() ? -1 : (int)(it - Pterritories->begin());
+}
+
+// add a conquered/received territory
+void Player::addTerritory(Territory* t) {
+    setPosition(*territoryPos, t, (int)Pterritories->size());
+    Pterritories->push_back(t);
+}
+
+// drop a lost territory (no-op if we don't have it): swap in the last one
+// and pop, instead of shifting everything after it
+void Player::removeTerritory(Territory* t) {
+    const int pos = positionOf(t);
+    if (pos < 0) return;
+    setPosition(*territoryPos, t, -1);
+    Territory* last = Pterritories->back();
+    Pterritories->pop_back();
+    if (pos < (int)Pterritories->size()) {
+        (*Pterritories)[pos] = last;
+        setPosition(*territoryPos, last, pos);
+    }
+}
+
+// rebuild the positions after the whole list was replaced
+void Player::indexTerritories() {
+    territoryPos->assign(territoryPos->size(), -1);
+    for (int i = 0; i < (int)Pterritories->size(); i++) setPosition(*territoryPos, (*Pterritories)[i], i);
+}
+
 // ================= Gameplay Methods =================
 
+// Our owner slot in the map: by id once GameEngine has bound the players,
+// by name otherwise
+namespace {
+    int ownerSlot(const Map* map, int id, const std::string& name) {
+        const int slot = map->getStore()->ownerOf(id);
+        return slot >= 0 ? slot : map->ownerIndex(name);
+    }
+}
+
 // toDefend method that returns a list of territories to defend
-std::vector<Territory*> Player::toDefend(Player p) {
-    // get territory
-    std::vector<Territory*> t2 = p.getTerritory();
+std::vector<Territory*> Player::toDefend() const {
+    // the map's index already has our territories listed
+    if (map != nullptr) {
+        return map->getOwnership().owned(ownerSlot(map, id, *pName));
+    }
 
-    // create list to store territories that will be defended
+    // no map: our own list, minus anything that changed hands behind our back
     std::vector<Territory*> defend;
-
-    // goes through list of territories belonging to player
-    for (int i = 0; i < t2.size(); i++) {
-        // store owner name
-        std::string owName = t2[i]->getOwner();
-
-        // selects the territories to defend based on if they belong to the player
-        if (owName == p.getPName()) {
-            // add the territory to the player defend list
-            defend.push_back(t2[i]);
-        }
+    for (auto* t : *Pterritories) {
+        if (t->isOwnedBy(*pName)) defend.push_back(t);
     }
-    // return the list of defending territories
     return defend;
 }
 
 // toAttack method that returns a list of territories to attack
-std::vector<Territory*> Player::toAttack(Player p) {
-    // get territory
-    std::vector<Territory*> t2 = p.getTerritory();
+std::vector<Territory*> Player::toAttack() const {
+    // the index keeps the enemy neighbors of our territories up to date
+    if (map != nullptr) {
+        return map->getOwnership().frontier(ownerSlot(map, id, *pName));
+    }
 
-    // create list to store territories to attack
+    // no map: enemy neighbors of our territories, each listed once
     std::vector<Territory*> attack;
-
-    // goes through list of territories belonging to other players
-    for (int i = 0; i < t2.size(); i++) {
-        // store owner name
-        std::string owName = t2[i]->getOwner();
-
-        // selects the territories to attack based on if they belong to the player or not
-        if (owName != p.getPName()) {
-            // add the territory to the player attack list
-            attack.push_back(t2[i]);
+    std::unordered_set<Territory*> seen;
+    for (auto* t : *Pterritories) {
+        for (auto* nb : *t->getAdjacentTerritories()) {
+            if (!nb->isOwnedBy(*pName) && seen.insert(nb).second) attack.push_back(nb);
         }
     }
-    // return the list of attacking territories
     return attack;
 }
 
+// territoryCount method that returns how many territories we hold
+int Player::territoryCount() const {
+    if (map != nullptr) {
+        return (int)map->getOwnership().owned(ownerSlot(map, id, *pName)).size();
+    }
+    int count = 0;
+    for (auto* t : *Pterritories) count += t->isOwnedBy(*pName);
+    return count;
+}
+
+// controlledContinents method that returns the continents we hold entirely
+std::vector<std::string> Player::controlledContinents() const {
+    std::vector<std::string> names;
+    if (map == nullptr) return names;
+    const OwnershipIndex& index = map->getOwnership();
+    for (int cont : index.controlled(ownerSlot(map, id, *pName))) {
+        names.push_back(map->getStore()->continentName(cont));
+    }
+    return names;
+}
+
 // issueOrder method creates an order object and puts it in the player's order list
 // issueOrder method creates an order object and puts it in the player's order list
 void Player::issueOrder() {
+    if (strategy != nullptr) {
+        strategy->issueOrder(*this);
+        return;
+    }
     // create a simple Deploy order (example) and add it to this player's order list
     if (!Pterritories->empty()) {
-        int* one = new int(1);
-        Orders* or2 = new Deploy(this, Pterritories->front(), one);
+        Orders* or2 = new Deploy(this, Pterritories->front(), 1);
         order->add(or2);
     }
 }
\ No newline at end of file
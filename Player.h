@@ -7,6 +7,18 @@
 #include "Cards.h"
 #include "Orders.h"
 
+class Player;
+
+// ================= PlayerStrategy =================
+// How a player picks its orders. A Player with a strategy hands issueOrder()
+// to it; without one it keeps the default (deploy 1 army at home).
+class PlayerStrategy {
+public:
+    virtual ~PlayerStrategy() {}
+    virtual void issueOrder(Player& player) = 0;   // add this turn's orders to player's list
+    virtual PlayerStrategy* clone() const = 0;     // for Player's copy constructor
+};
+
 // ================= Player Class =================
 // Represents a single player in the game, holding their
 // name, territories, deck of cards, and orders list.
@@ -22,25 +34,50 @@ public:
 
     // ===== Getters =====
     std::string getPName() const;
+    int getId() const;                 // index in the game's player list (-1 if none; Neutral: one past the end)
     std::vector<Territory*> getTerritory() const;
     Deck* getDeck() const;             // returns pointer to Deck
     OrdersList* getOrder() const;      // returns pointer to OrdersList
+    Map* getMap() const;               // map being played (nullptr if none)
 
     // ===== Setters =====
     void setPName(std::string pName);
+    void setId(int id);                      // assigned by GameEngine
     void setTerritory(std::vector<Territory*> Pterritories);
     void setDeck(Deck* deck);                // sets Deck contents
     void setOrdersList(OrdersList* order);   // sets OrdersList contents
+    void setMap(Map* map);                   // not owned; set by GameEngine
+    void setStrategy(PlayerStrategy* s);     // takes ownership (nullptr: default orders)
+    PlayerStrategy* getStrategy() const;
+
+    // ===== Ownership changes (order execution) =====
+    // O(1) both ways; removing moves our last territory into the gap, so
+    // the list keeps no particular order.
+    void addTerritory(Territory* t);
+    void removeTerritory(Territory* t);   // no-op if we don't hold it
 
     // ===== Gameplay methods =====
-    std::vector<Territory*> toDefend(Player p);   // territories to defend
-    std::vector<Territory*> toAttack(Player p);   // territories to attack
-    void issueOrder();                            // issue an order
+    // With a map: straight from its OwnershipIndex, O(result).
+    // Without one: scan of our own territory list (and their neighbors).
+    std::vector<Territory*> toDefend() const;   // territories we own
+    std::vector<Territory*> toAttack() const;   // enemy territories next to ours
+    // Reinforcement inputs: O(1) and O(result) with a map. Continents are
+    // only known through a map (none without one).
+    int territoryCount() const;
+    std::vector<std::string> controlledContinents() const;   // names, unordered
+    void issueOrder();                            // issue this turn's orders (strategy's, if any)
 
 private:
     // ===== Member variables =====
     std::string* pName;                          // player's name
     std::vector<Territory*>* Pterritories;       // territories owned
+    std::vector<int>* territoryPos;              // store slot -> position in Pterritories (-1: none)
     Deck* deck;                                  // deck of cards
     OrdersList* order;                           // player's orders list
+    int id;                                      // player index (OrderRecord::player)
+    Map* map;                                    // not owned (GameEngine's map)
+    PlayerStrategy* strategy;                    // owned; nullptr = default orders
+
+    void indexTerritories();                     // rebuild territoryPos from Pterritories
+    int positionOf(const Territory* t) const;    // -1 if we don't hold t
 };
\ No newline at end of file
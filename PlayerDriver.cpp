@@ -35,10 +35,10 @@ void testPlayer() {
     Player p1("Joe", territories, d1, ordli1);
 
     // ===== Test methods =====
-    auto defendList = p1.toDefend(p1);
+    auto defendList = p1.toDefend();
     cout << "toDefend() returned " << defendList.size() << " territories\n";
 
-    auto attackList = p1.toAttack(p1);
+    auto attackList = p1.toAttack();
     cout << "toAttack() returned " << attackList.size() << " territories\n";
 
     p1.issueOrder();
@@ -81,11 +81,11 @@ int main() {
     cout << "Player created.\n";
 
     cout << "Testing toDefend...\n";
-    auto defendList = p1.toDefend(p1);
+    auto defendList = p1.toDefend();
     cout << "toDefend() returned " << defendList.size() << " territories\n";
 
     cout << "Testing toAttack...\n";
-    auto attackList = p1.toAttack(p1);
+    auto attackList = p1.toAttack();
     cout << "toAttack() returned " << attackList.size() << " territories\n";
 
     cout << "Testing issueOrder...\n";
@@ -0,0 +1,86 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// ThreadPool
+// ============================================================================
+// Fixed set of worker threads pulling tasks from one FIFO queue.
+// Header-only because submit() is a template.
+//  - submit(f) queues f and returns a std::future for its result
+//  - the destructor finishes every queued task, then joins the workers
+// Tasks must not throw past the future (exceptions are stored in it).
+
+class ThreadPool {
+private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    bool stopping_;
+
+    void workerLoop() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (stopping_ && tasks_.empty()) return;
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+            task();
+        }
+    }
+
+public:
+    // threads <= 0 means "one per hardware thread"
+    explicit ThreadPool(int threads = 0) : stopping_(false) {
+        if (threads <= 0) threads = defaultThreadCount();
+        workers_.reserve(threads);
+        for (int i = 0; i < threads; i++) workers_.emplace_back(&ThreadPool::workerLoop, this);
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        ready_.notify_all();
+        for (auto& w : workers_) w.join();
+    }
+
+    template <typename F>
+    auto submit(F f) -> std::future<decltype(f())> {
+        typedef decltype(f()) Result;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::move(f));
+        std::future<Result> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push([task] { (*task)(); });
+        }
+        ready_.notify_one();
+        return result;
+    }
+
+    int size() const { return (int)workers_.size(); }
+
+    static int defaultThreadCount() {
+        unsigned n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : (int)n;
+    }
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,183 @@
+#include "GameEngine.h"
+#include "Map.h"
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Batch balance runner: many independent headless games on one map.
+//   ./Warzone_tournament [-j N] [-n games] [-p players] [-t turns] [-s seed] [-v] <map>
+// The map (.map or .wzb) is loaded and validated once and split into a
+// shared, read-only MapTopology and a starting MapState. Each worker builds
+// one board on that topology the first time it runs a game and resets it
+// to the starting state for every game after that, so a game costs a state
+// copy rather than a map copy. Games run on a work-stealing pool of N
+// workers (default: one per core). Game i plays with seed mix(seed + i), which feeds its combat, its
+// players' choices and its decks: results don't depend on N or on which
+// worker ran which game.
+//
+// Output is JSON Lines on stdout: one object per game with -v (in game
+// order), one per player, then one summary object:
+//   {"game":0,"seed":123,"winner":2,"turns":97,"ms":11.8}
+//   {"player":0,"wins":240,"win_rate":0.24}
+//   {"summary":true,"games":1000,"players":4,"decided":998,"turn_limit":2,
+//    "turns_mean":104.2,"latency_ms":{"p50":11.1,"p90":15.2,"p99":21.9,"max":30.4},
+//    "wall_ms":3100.2,"games_per_s":322.5,"turns_per_s":33601.7,"threads":4,"steals":9}
+// Exit code: 0 after a run, 1 if the map can't be used, 2 on bad arguments.
+
+namespace {
+    struct GameRecord {
+        std::uint64_t seed = 0;
+        SimulationResult result;
+        double ms = 0.0;
+    };
+
+    double msSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    bool endsWith(const std::string& s, const char* suffix) {
+        std::size_t n = std::strlen(suffix);
+        return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+    }
+
+    // splitmix64: neighbouring game numbers get unrelated seeds
+    std::uint64_t mix(std::uint64_t z) {
+        z += 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Nearest-rank percentile of sorted values
+    double percentile(const std::vector<double>& sorted, double p) {
+        if (sorted.empty()) return 0.0;
+        std::size_t rank = (std::size_t)(p / 100.0 * sorted.size() + 0.999999);
+        if (rank < 1) rank = 1;
+        if (rank > sorted.size()) rank = sorted.size();
+        return sorted[rank - 1];
+    }
+
+    int usage() {
+        std::cerr << "Usage: Warzone_tournament [-j N] [-n games] [-p players] [-t turns] [-s seed] [-v] <map>\n";
+        return 2;
+    }
+}
+
+int main(int argc, char** argv) {
+    int threads = 0;
+    int games = 1000;
+    int players = 4;
+    int turnLimit = 1000;
+    std::uint64_t baseSeed = 1;
+    bool verbose = false;
+    std::string path;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-j" || arg == "-n" || arg == "-p" || arg == "-t" || arg == "-s") {
+            if (++i >= argc) return usage();
+            const long long value = std::atoll(argv[i]);
+            if (arg == "-s") {
+                baseSeed = (std::uint64_t)value;
+                continue;
+            }
+            if (value <= 0) return usage();
+            if (arg == "-j") threads = (int)value;
+            else if (arg == "-n") games = (int)value;
+            else if (arg == "-p") players = (int)value;
+            else turnLimit = (int)value;
+        } else if (arg == "-v") {
+            verbose = true;
+        } else if (arg == "-h" || arg == "--help" || !path.empty()) {
+            return usage();
+        } else {
+            path = arg;
+        }
+    }
+    if (path.empty()) return usage();
+
+    // One parse for the whole tournament
+    MapLoadOptions options;
+    options.silent = true;
+    MapLoader loader;
+    const bool loaded = endsWith(path, ".wzb") ? loader.loadBinary(path, options)
+                                               : loader.loadMap(path, options);
+    if (!loaded || loader.getMap() == nullptr) {
+        const std::string& why = loader.getLastLoadStats().error;
+        std::cerr << "Cannot use " << path << ": " << (why.empty() ? "map did not validate" : why) << "\n";
+        return 1;
+    }
+    Map* map = loader.getMap();
+    if (!map->hasAdjacencyIndex()) map->buildAdjacencyIndex();
+    if ((int)static_cast<const Map*>(map)->getTerritories()->size() < players) {
+        std::cerr << "Cannot use " << path << ": fewer territories than players\n";
+        return 1;
+    }
+    const std::shared_ptr<const MapTopology> topology = map->topology();
+    const MapState initial = map->saveState();
+
+    std::vector<GameRecord> records(games);
+    WorkStealingPool pool(threads);
+    std::vector<Map*> boards(pool.size(), nullptr);   // per worker, built on first use
+    auto start = std::chrono::steady_clock::now();
+    pool.run(games, [&](int g, int worker) {
+        GameRecord& r = records[g];   // each game writes only its own record
+        r.seed = mix(baseSeed + (std::uint64_t)g);
+        auto begin = std::chrono::steady_clock::now();
+        if (boards[worker] == nullptr) boards[worker] = new Map(topology, initial);
+        r.result = GameEngine::simulate(r.seed, *boards[worker], initial, players, turnLimit);
+        r.ms = msSince(begin);
+    });
+    const double wallMs = msSince(start);
+    for (auto* b : boards) delete b;
+
+    std::vector<int> wins(players, 0);
+    std::vector<double> latencies;
+    latencies.reserve(games);
+    long long turns = 0;
+    int decided = 0;
+    for (int g = 0; g < games; g++) {
+        const GameRecord& r = records[g];
+        if (r.result.winner >= 0) {
+            wins[r.result.winner]++;
+            decided++;
+        }
+        turns += r.result.turns;
+        latencies.push_back(r.ms);
+        if (verbose) {
+            std::cout << "{\"game\":" << g << ",\"seed\":" << r.seed
+                      << ",\"winner\":" << r.result.winner
+                      << ",\"turns\":" << r.result.turns
+                      << ",\"ms\":" << r.ms << "}\n";
+        }
+    }
+    for (int p = 0; p < players; p++) {
+        std::cout << "{\"player\":" << p << ",\"wins\":" << wins[p]
+                  << ",\"win_rate\":" << (double)wins[p] / games << "}\n";
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    const double seconds = wallMs / 1000.0;
+    std::cout << "{\"summary\":true,\"games\":" << games
+              << ",\"players\":" << players
+              << ",\"decided\":" << decided
+              << ",\"turn_limit\":" << games - decided
+              << ",\"turns_mean\":" << (double)turns / games
+              << ",\"latency_ms\":{\"p50\":" << percentile(latencies, 50)
+              << ",\"p90\":" << percentile(latencies, 90)
+              << ",\"p99\":" << percentile(latencies, 99)
+              << ",\"max\":" << latencies.back() << "}"
+              << ",\"wall_ms\":" << wallMs
+              << ",\"games_per_s\":" << (seconds > 0.0 ? games / seconds : 0.0)
+              << ",\"turns_per_s\":" << (seconds > 0.0 ? turns / seconds : 0.0)
+              << ",\"threads\":" << pool.size()
+              << ",\"steals\":" << pool.steals() << "}\n";
+    return 0;
+}
@@ -0,0 +1,112 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// WorkStealingPool
+// ============================================================================
+// Runs a batch of independent jobs 0..count-1 on a fixed number of threads.
+// Header-only because run() is a template.
+//  - every worker starts with an equal, contiguous share of the job indices
+//    and takes them front to back
+//  - a worker whose share is used up steals the back half of what is left
+//    of another worker's share, so a few long jobs don't leave the others
+//    idle and there is no central queue for every worker to fight over
+// A share is a [begin, end) range with its own lock, held just long enough
+// to move one bound. Jobs run outside every lock and must not throw.
+
+class WorkStealingPool {
+private:
+    struct Share {
+        std::mutex lock;
+        int begin = 0;
+        int end = 0;
+    };
+
+    int threads_;
+    std::atomic<long long> steals_;
+
+    static bool takeOwn(Share& own, int& job) {
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (own.begin >= own.end) return false;
+        job = own.begin++;
+        return true;
+    }
+
+    // Moves the back half of some other share into ours and hands out its
+    // first job; false once every share is empty.
+    bool steal(std::vector<Share>& shares, int thief, int& job) {
+        const int n = (int)shares.size();
+        for (int k = 1; k < n; k++) {
+            Share& victim = shares[(thief + k) % n];
+            int from, to;
+            {
+                std::lock_guard<std::mutex> guard(victim.lock);
+                const int left = victim.end - victim.begin;
+                if (left <= 0) continue;
+                to = victim.end;
+                from = victim.end - (left + 1) / 2;
+                victim.end = from;
+            }
+            {
+                std::lock_guard<std::mutex> guard(shares[thief].lock);
+                shares[thief].begin = from + 1;
+                shares[thief].end = to;
+            }
+            steals_++;
+            job = from;
+            return true;
+        }
+        return false;
+    }
+
+public:
+    // threads <= 0 means "one per hardware thread"
+    explicit WorkStealingPool(int threads = 0) : threads_(threads), steals_(0) {
+        if (threads_ <= 0) {
+            unsigned n = std::thread::hardware_concurrency();
+            threads_ = n == 0 ? 1 : (int)n;
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Calls job(index, worker) once for every index in [0, count) and returns
+    // when all of them are done. worker is in [0, size()).
+    template <typename F>
+    void run(int count, F job) {
+        if (count <= 0) return;
+        const int n = std::min(threads_, count);
+        std::vector<Share> shares(n);
+        for (int w = 0; w < n; w++) {
+            shares[w].begin = (int)((long long)count * w / n);
+            shares[w].end = (int)((long long)count * (w + 1) / n);
+        }
+
+        auto work = [this, &shares, &job](int worker) {
+            int index;
+            for (;;) {
+                if (!takeOwn(shares[worker], index) && !steal(shares, worker, index)) return;
+                job(index, worker);
+            }
+        };
+
+        // the calling thread is worker 0
+        std::vector<std::thread> helpers;
+        helpers.reserve(n - 1);
+        for (int w = 1; w < n; w++) helpers.emplace_back(work, w);
+        work(0);
+        for (auto& t : helpers) t.join();
+    }
+
+    int size() const { return threads_; }
+    long long steals() const { return steals_; }   // over every run() so far
+};
+
+#endif // WORKSTEALINGPOOL_H